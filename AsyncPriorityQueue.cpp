@@ -0,0 +1,151 @@
+#include "AsyncPriorityQueue.h"
+
+/**
+ * @brief Constructs an awaiter for the given queue.
+ *
+ * @param owner The queue being waited on.
+ */
+AsyncPriorityQueue::PopAwaiter::PopAwaiter(AsyncPriorityQueue* owner)
+    : queue(owner), handle(nullptr), next(nullptr), value(0) {}
+
+/**
+ * @brief Takes the minimum value at once if the queue is not empty.
+ *
+ * @return True if the coroutine does not need to suspend.
+ */
+bool AsyncPriorityQueue::PopAwaiter::await_ready() {
+    if (this->queue->heap.isEmpty()) {
+        return false;
+    }
+    Node* minNode = this->queue->heap.extractMin();
+    this->value = minNode->getKey();
+    delete minNode;
+    return true;
+}
+
+/**
+ * @brief Adds the suspended coroutine to the back of the waiters.
+ *
+ * @param awaiting The coroutine that is suspended.
+ */
+void AsyncPriorityQueue::PopAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    this->handle = awaiting;
+    if (this->queue->lastWaiter == nullptr) {
+        this->queue->firstWaiter = this;
+    }
+    else {
+        this->queue->lastWaiter->next = this;
+    }
+    this->queue->lastWaiter = this;
+    this->queue->waiterCount += 1;
+}
+
+/**
+ * @brief Returns the value handed to this waiter.
+ *
+ * @return long long The popped value.
+ */
+long long AsyncPriorityQueue::PopAwaiter::await_resume() const {
+    return this->value;
+}
+
+/**
+ * @brief Constructs an empty queue.
+ */
+AsyncPriorityQueue::AsyncPriorityQueue()
+    : firstWaiter(nullptr), lastWaiter(nullptr), waiterCount(0) {}
+
+/**
+ * @brief Hands the smallest values to the oldest waiters and resumes them.
+ */
+void AsyncPriorityQueue::wakeWaiters() {
+    PopAwaiter* woken = nullptr;
+    PopAwaiter* wokenLast = nullptr;
+
+    while (this->firstWaiter != nullptr && !this->heap.isEmpty()) {
+        PopAwaiter* waiter = this->firstWaiter;
+        this->firstWaiter = waiter->next;
+        if (this->firstWaiter == nullptr) {
+            this->lastWaiter = nullptr;
+        }
+        this->waiterCount -= 1;
+
+        Node* minNode = this->heap.extractMin();
+        waiter->value = minNode->getKey();
+        delete minNode;
+
+        waiter->next = nullptr;
+        if (wokenLast == nullptr) {
+            woken = waiter;
+        }
+        else {
+            wokenLast->next = waiter;
+        }
+        wokenLast = waiter;
+    }
+
+    while (woken != nullptr) {
+        // The awaiter lives in the coroutine frame, which may be gone once resumed.
+        PopAwaiter* next = woken->next;
+        woken->handle.resume();
+        woken = next;
+    }
+}
+
+/**
+ * @brief Inserts a value and resumes a waiting coroutine if there is one.
+ *
+ * @param value The value to be inserted.
+ */
+void AsyncPriorityQueue::push(long long value) {
+    this->heap.insert(value);
+    this->wakeWaiters();
+}
+
+/**
+ * @brief Inserts several values, then resumes up to that many waiting coroutines.
+ *
+ * @param values The values to be inserted.
+ */
+void AsyncPriorityQueue::push(const std::vector<long long>& values) {
+    for (long long value : values) {
+        this->heap.insert(value);
+    }
+    this->wakeWaiters();
+}
+
+/**
+ * @brief Returns an awaitable that yields the minimum value.
+ *
+ * @return PopAwaiter The awaitable to co_await.
+ */
+AsyncPriorityQueue::PopAwaiter AsyncPriorityQueue::pop() {
+    return PopAwaiter(this);
+}
+
+/**
+ * @brief Checks if the queue holds no values.
+ *
+ * @return True if no value is queued, false otherwise.
+ */
+bool AsyncPriorityQueue::isEmpty() const {
+    return this->heap.isEmpty();
+}
+
+/**
+ * @brief Returns the number of queued values.
+ *
+ * @return long long The number of values.
+ */
+long long AsyncPriorityQueue::getSize() const {
+    return this->heap.getSize();
+}
+
+/**
+ * @brief Returns the number of suspended consumers.
+ *
+ * @return int The number of waiters.
+ */
+int AsyncPriorityQueue::getWaiterCount() const {
+    return this->waiterCount;
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <coroutine>
+#include <vector>
+
+/**
+ * @class AsyncPriorityQueue
+ * @brief A Fibonacci Heap that coroutines can wait on.
+ *
+ * co_await queue.pop() returns the minimum value at once if the heap is not
+ * empty and otherwise suspends the coroutine. A later push hands its values to
+ * the waiting coroutines in arrival order and resumes them directly from
+ * inside push, on the producer's thread, without going through a scheduler.
+ * Pushing a batch resumes as many waiters as it has values.
+ *
+ * The queue is single-threaded and must outlive every coroutine waiting on it.
+ * Requires C++20.
+ */
+class AsyncPriorityQueue
+{
+public:
+    /**
+     * @brief Awaitable returned by pop.
+     *
+     * It lives in the frame of the waiting coroutine and doubles as the node
+     * of the queue's intrusive list of waiters.
+     */
+    class PopAwaiter {
+    private:
+        friend class AsyncPriorityQueue;
+
+        AsyncPriorityQueue* queue;         ///< The queue being waited on
+        std::coroutine_handle<> handle;    ///< The suspended coroutine
+        PopAwaiter* next;                  ///< The next waiter in arrival order
+        long long value;                   ///< The value handed to this waiter
+
+    public:
+        explicit PopAwaiter(AsyncPriorityQueue* owner);
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> awaiting);
+        long long await_resume() const;
+    };
+
+private:
+    FibonacciHeap heap;      ///< Values nobody is waiting for yet
+    PopAwaiter* firstWaiter; ///< Oldest suspended consumer
+    PopAwaiter* lastWaiter;  ///< Newest suspended consumer
+    int waiterCount;         ///< Number of suspended consumers
+
+    /**
+     * @brief Hands the smallest values to the oldest waiters and resumes them.
+     *
+     * All values are assigned before any waiter is resumed, so a batch wakes
+     * its waiters together.
+     */
+    void wakeWaiters();
+
+public:
+    /**
+     * @brief Constructs an empty queue.
+     */
+    AsyncPriorityQueue();
+
+    /**
+     * @brief Inserts a value and resumes a waiting coroutine if there is one.
+     *
+     * @param value The value to be inserted.
+     */
+    void push(long long value);
+
+    /**
+     * @brief Inserts several values, then resumes up to that many waiting coroutines.
+     *
+     * @param values The values to be inserted.
+     */
+    void push(const std::vector<long long>& values);
+
+    /**
+     * @brief Returns an awaitable that yields the minimum value.
+     *
+     * @return PopAwaiter The awaitable to co_await.
+     */
+    PopAwaiter pop();
+
+    /**
+     * @brief Checks if the queue holds no values.
+     *
+     * @return True if no value is queued, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the number of queued values.
+     *
+     * @return long long The number of values.
+     */
+    long long getSize() const;
+
+    /**
+     * @brief Returns the number of suspended consumers.
+     *
+     * @return int The number of waiters.
+     */
+    int getWaiterCount() const;
+};
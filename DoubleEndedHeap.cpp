@@ -0,0 +1,319 @@
+#include "DoubleEndedHeap.h"
+#include <cstddef>
+
+/**
+ * @brief Constructs an empty heap.
+ *
+ * @param capacity The number of elements to reserve room for.
+ */
+DoubleEndedHeap::DoubleEndedHeap(int capacity) {
+    if (capacity > 0) {
+        this->entries.reserve(size_t(capacity));
+        this->positions.reserve(size_t(capacity));
+    }
+}
+
+/**
+ * @brief Stores an element at a position and records its new position.
+ *
+ * @param position The position in entries.
+ * @param entry The element.
+ */
+void DoubleEndedHeap::place(int position, const Entry& entry) {
+    this->entries[position] = entry;
+    this->positions[entry.handle] = position;
+}
+
+/**
+ * @brief Exchanges the elements at two positions.
+ *
+ * @param a The first position.
+ * @param b The second position.
+ */
+void DoubleEndedHeap::swapEntries(int a, int b) {
+    Entry first = this->entries[a];
+    this->place(a, this->entries[b]);
+    this->place(b, first);
+}
+
+/**
+ * @brief Moves a low element up while it is smaller than the low element of its parent.
+ *
+ * @param position The position of the element.
+ */
+void DoubleEndedHeap::siftUpMin(int position) {
+    while (position >= 2) {
+        int parentLow = 2 * ((position / 2 - 1) / 2);
+        if (this->entries[position].key >= this->entries[parentLow].key) {
+            break;
+        }
+        this->swapEntries(position, parentLow);
+        position = parentLow;
+    }
+}
+
+/**
+ * @brief Moves a high element up while it is larger than the high element of its parent.
+ *
+ * @param position The position of the element.
+ */
+void DoubleEndedHeap::siftUpMax(int position) {
+    while (position >= 2) {
+        int parentHigh = 2 * ((position / 2 - 1) / 2) + 1;
+        if (this->entries[position].key <= this->entries[parentHigh].key) {
+            break;
+        }
+        this->swapEntries(position, parentHigh);
+        position = parentHigh;
+    }
+}
+
+/**
+ * @brief Moves the low element of a node down until the heap is valid again.
+ *
+ * @param position The position of the low element.
+ */
+void DoubleEndedHeap::siftDownMin(int position) {
+    int size = int(this->entries.size());
+    while (true) {
+        // Keep the node ordered; the element that was high is then sifted on.
+        if (position + 1 < size && this->entries[position].key > this->entries[position + 1].key) {
+            this->swapEntries(position, position + 1);
+        }
+
+        int node = position / 2;
+        int child = 2 * (2 * node + 1);
+        if (child >= size) {
+            break;
+        }
+        int other = child + 2;
+        if (other < size && this->entries[other].key < this->entries[child].key) {
+            child = other;
+        }
+        if (this->entries[child].key >= this->entries[position].key) {
+            break;
+        }
+        this->swapEntries(position, child);
+        position = child;
+    }
+}
+
+/**
+ * @brief Moves the high element of a node down until the heap is valid again.
+ *
+ * @param position The position of the high element.
+ */
+void DoubleEndedHeap::siftDownMax(int position) {
+    int size = int(this->entries.size());
+    while (true) {
+        int node = position / 2;
+        int low = 2 * node;
+        if (position != low && this->entries[low].key > this->entries[position].key) {
+            this->swapEntries(low, position);
+        }
+
+        // The largest element of a child node is its high one, or its only
+        // element if it is the last node and holds one.
+        int best = -1;
+        for (int child = 2 * node + 1; child <= 2 * node + 2; child++) {
+            int candidate = 2 * child + 1 < size ? 2 * child + 1 : 2 * child;
+            if (candidate < size && (best == -1 || this->entries[candidate].key > this->entries[best].key)) {
+                best = candidate;
+            }
+        }
+        if (best == -1 || this->entries[best].key <= this->entries[position].key) {
+            break;
+        }
+        this->swapEntries(position, best);
+        position = best;
+    }
+}
+
+/**
+ * @brief Removes the element at a position and returns its handle to the free list.
+ *
+ * @param position The position of the element.
+ */
+void DoubleEndedHeap::removeAt(int position) {
+    int handle = this->entries[position].handle;
+    int last = int(this->entries.size()) - 1;
+
+    if (position != last) {
+        // Treat the element as minus or plus infinity: move it to the root
+        // along the low or high path, then replace it with the last element.
+        bool high = position % 2 == 1;
+        while (position >= 2) {
+            int parent = 2 * ((position / 2 - 1) / 2) + (high ? 1 : 0);
+            this->swapEntries(position, parent);
+            position = parent;
+        }
+
+        this->place(position, this->entries[last]);
+        this->entries.pop_back();
+        if (high) {
+            this->siftDownMax(position);
+        }
+        else {
+            this->siftDownMin(position);
+        }
+    }
+    else {
+        this->entries.pop_back();
+    }
+
+    this->positions[handle] = -1;
+    this->freeHandles.push_back(handle);
+}
+
+/**
+ * @brief Inserts an element.
+ *
+ * @param key The key of the element.
+ * @param id Optional identifier carried with the key (-1 if unused).
+ * @return int The handle of the element, for erase and keyOf.
+ */
+int DoubleEndedHeap::insert(long long key, int id) {
+    int handle;
+    if (!this->freeHandles.empty()) {
+        handle = this->freeHandles.back();
+        this->freeHandles.pop_back();
+    }
+    else {
+        handle = int(this->positions.size());
+        this->positions.push_back(-1);
+    }
+
+    int position = int(this->entries.size());
+    this->entries.push_back(Entry{ key, handle, id });
+    this->positions[handle] = position;
+
+    if (position % 2 == 1) {
+        // The node now holds two elements; order them, then sift the one that moved.
+        if (key < this->entries[position - 1].key) {
+            this->swapEntries(position, position - 1);
+            this->siftUpMin(position - 1);
+        }
+        else {
+            this->siftUpMax(position);
+        }
+    }
+    else if (position >= 2) {
+        // A lone element counts as both the low and the high element of its node.
+        int parentLow = 2 * ((position / 2 - 1) / 2);
+        if (key < this->entries[parentLow].key) {
+            this->siftUpMin(position);
+        }
+        else if (key > this->entries[parentLow + 1].key) {
+            this->siftUpMax(position);
+        }
+    }
+    return handle;
+}
+
+/**
+ * @brief Removes the element with the minimum key.
+ *
+ * @param key Set to the key of the removed element.
+ * @param id Set to the id of the removed element.
+ * @return bool True if an element was removed, false if the heap was empty.
+ */
+bool DoubleEndedHeap::extractMin(long long& key, int& id) {
+    if (this->entries.empty()) {
+        return false;
+    }
+    key = this->entries[0].key;
+    id = this->entries[0].id;
+    this->removeAt(0);
+    return true;
+}
+
+/**
+ * @brief Removes the element with the maximum key.
+ *
+ * @param key Set to the key of the removed element.
+ * @param id Set to the id of the removed element.
+ * @return bool True if an element was removed, false if the heap was empty.
+ */
+bool DoubleEndedHeap::extractMax(long long& key, int& id) {
+    if (this->entries.empty()) {
+        return false;
+    }
+    int position = this->entries.size() == 1 ? 0 : 1;
+    key = this->entries[position].key;
+    id = this->entries[position].id;
+    this->removeAt(position);
+    return true;
+}
+
+/**
+ * @brief Removes an element by its handle.
+ *
+ * @param handle The handle returned by insert.
+ * @return bool True if the element was removed, false if the handle is not in use.
+ */
+bool DoubleEndedHeap::erase(int handle) {
+    if (!this->contains(handle)) {
+        return false;
+    }
+    this->removeAt(this->positions[handle]);
+    return true;
+}
+
+/**
+ * @brief Checks whether a handle refers to an element of the heap.
+ *
+ * @param handle The handle to be checked.
+ * @return bool True if the handle is in use, false otherwise.
+ */
+bool DoubleEndedHeap::contains(int handle) const {
+    return handle >= 0 && size_t(handle) < this->positions.size() && this->positions[handle] != -1;
+}
+
+/**
+ * @brief Returns the key of an element.
+ *
+ * @param handle The handle returned by insert.
+ * @return long long The key of the element, 0 if the handle is not in use.
+ */
+long long DoubleEndedHeap::keyOf(int handle) const {
+    return this->contains(handle) ? this->entries[this->positions[handle]].key : 0;
+}
+
+/**
+ * @brief Returns the minimum value in the heap.
+ *
+ * @return long long The minimum value in the heap, 0 if the heap is empty.
+ */
+long long DoubleEndedHeap::getMinValue() const {
+    return this->entries.empty() ? 0 : this->entries[0].key;
+}
+
+/**
+ * @brief Returns the maximum value in the heap.
+ *
+ * @return long long The maximum value in the heap, 0 if the heap is empty.
+ */
+long long DoubleEndedHeap::getMaxValue() const {
+    if (this->entries.empty()) {
+        return 0;
+    }
+    return this->entries[this->entries.size() == 1 ? 0 : 1].key;
+}
+
+/**
+ * @brief Checks if the heap is empty.
+ *
+ * @return True if the heap is empty, false otherwise.
+ */
+bool DoubleEndedHeap::isEmpty() const {
+    return this->entries.empty();
+}
+
+/**
+ * @brief Returns the number of elements in the heap.
+ *
+ * @return int The number of elements in the heap.
+ */
+int DoubleEndedHeap::getSize() const {
+    return int(this->entries.size());
+}
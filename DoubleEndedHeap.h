@@ -0,0 +1,170 @@
+#pragma once
+#include <vector>
+
+/**
+ * @class DoubleEndedHeap
+ * @brief A double-ended priority queue with constant time access to both the
+ * minimum and the maximum.
+ *
+ * The elements are kept in an interval heap: a complete binary tree stored in
+ * one array, where every tree node holds two elements, a low and a high one,
+ * and the interval of every node contains the intervals of its children. The
+ * low elements form a min-heap and the high elements a max-heap, so the root
+ * holds the minimum and the maximum. Every element is stored once, in place,
+ * with no per-element allocation. insert returns a handle that stays valid
+ * until its element is removed; the handle is reused afterwards.
+ */
+class DoubleEndedHeap
+{
+private:
+    /**
+     * @brief One element of the heap.
+     */
+    struct Entry {
+        long long key;   ///< The key of the element
+        int handle;      ///< Handle returned by insert
+        int id;          ///< Caller supplied identifier carried with the key
+    };
+
+    std::vector<Entry> entries;    ///< Tree node k holds entries 2k (low) and 2k + 1 (high)
+    std::vector<int> positions;    ///< Position of each handle in entries, -1 if free
+    std::vector<int> freeHandles;  ///< Handles that can be reused
+
+    /**
+     * @brief Stores an element at a position and records its new position.
+     *
+     * @param position The position in entries.
+     * @param entry The element.
+     */
+    void place(int position, const Entry& entry);
+
+    /**
+     * @brief Exchanges the elements at two positions.
+     *
+     * @param a The first position.
+     * @param b The second position.
+     */
+    void swapEntries(int a, int b);
+
+    /**
+     * @brief Moves a low element up while it is smaller than the low element of its parent.
+     *
+     * @param position The position of the element.
+     */
+    void siftUpMin(int position);
+
+    /**
+     * @brief Moves a high element up while it is larger than the high element of its parent.
+     *
+     * @param position The position of the element.
+     */
+    void siftUpMax(int position);
+
+    /**
+     * @brief Moves the low element of a node down until the heap is valid again.
+     *
+     * @param position The position of the low element.
+     */
+    void siftDownMin(int position);
+
+    /**
+     * @brief Moves the high element of a node down until the heap is valid again.
+     *
+     * @param position The position of the high element.
+     */
+    void siftDownMax(int position);
+
+    /**
+     * @brief Removes the element at a position and returns its handle to the free list.
+     *
+     * @param position The position of the element.
+     */
+    void removeAt(int position);
+
+public:
+    /**
+     * @brief Constructs an empty heap.
+     *
+     * @param capacity The number of elements to reserve room for.
+     */
+    DoubleEndedHeap(int capacity = 0);
+
+    /**
+     * @brief Inserts an element.
+     *
+     * @param key The key of the element.
+     * @param id Optional identifier carried with the key (-1 if unused).
+     * @return int The handle of the element, for erase and keyOf.
+     */
+    int insert(long long key, int id = -1);
+
+    /**
+     * @brief Removes the element with the minimum key.
+     *
+     * @param key Set to the key of the removed element.
+     * @param id Set to the id of the removed element.
+     * @return bool True if an element was removed, false if the heap was empty.
+     */
+    bool extractMin(long long& key, int& id);
+
+    /**
+     * @brief Removes the element with the maximum key.
+     *
+     * @param key Set to the key of the removed element.
+     * @param id Set to the id of the removed element.
+     * @return bool True if an element was removed, false if the heap was empty.
+     */
+    bool extractMax(long long& key, int& id);
+
+    /**
+     * @brief Removes an element by its handle.
+     *
+     * @param handle The handle returned by insert.
+     * @return bool True if the element was removed, false if the handle is not in use.
+     */
+    bool erase(int handle);
+
+    /**
+     * @brief Checks whether a handle refers to an element of the heap.
+     *
+     * @param handle The handle to be checked.
+     * @return bool True if the handle is in use, false otherwise.
+     */
+    bool contains(int handle) const;
+
+    /**
+     * @brief Returns the key of an element.
+     *
+     * @param handle The handle returned by insert.
+     * @return long long The key of the element, 0 if the handle is not in use.
+     */
+    long long keyOf(int handle) const;
+
+    /**
+     * @brief Returns the minimum value in the heap.
+     *
+     * @return long long The minimum value in the heap, 0 if the heap is empty.
+     */
+    long long getMinValue() const;
+
+    /**
+     * @brief Returns the maximum value in the heap.
+     *
+     * @return long long The maximum value in the heap, 0 if the heap is empty.
+     */
+    long long getMaxValue() const;
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return True if the heap is empty, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the number of elements in the heap.
+     *
+     * @return int The number of elements in the heap.
+     */
+    int getSize() const;
+};
@@ -0,0 +1,44 @@
+#include "EventLoop.h"
+
+/**
+ * @brief Adds a suspended coroutine to the back of the loop.
+ *
+ * @param handle The coroutine to be resumed later.
+ */
+void EventLoop::post(std::coroutine_handle<> handle) {
+    this->ready.push_back(handle);
+}
+
+/**
+ * @brief Suspends the calling coroutine and resumes it on a later turn of the loop.
+ *
+ * @return ScheduleAwaiter The awaitable to co_await.
+ */
+EventLoop::ScheduleAwaiter EventLoop::schedule() {
+    return ScheduleAwaiter{ this };
+}
+
+/**
+ * @brief Resumes ready coroutines until none are left.
+ *
+ * @return int The number of coroutines that were resumed.
+ */
+int EventLoop::run() {
+    int resumed = 0;
+    while (!this->ready.empty()) {
+        std::coroutine_handle<> handle = this->ready.front();
+        this->ready.pop_front();
+        handle.resume();
+        resumed += 1;
+    }
+    return resumed;
+}
+
+/**
+ * @brief Checks if any coroutine is ready to run.
+ *
+ * @return True if no coroutine is ready, false otherwise.
+ */
+bool EventLoop::isEmpty() const {
+    return this->ready.empty();
+}
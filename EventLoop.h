@@ -0,0 +1,78 @@
+#pragma once
+#include <coroutine>
+#include <deque>
+#include <exception>
+
+/**
+ * @class AsyncTask
+ * @brief A fire-and-forget coroutine.
+ *
+ * The coroutine starts running as soon as it is called and frees itself when
+ * it finishes. Requires C++20.
+ */
+class AsyncTask
+{
+public:
+    /**
+     * @brief The promise type that makes a function returning AsyncTask a coroutine.
+     */
+    struct promise_type {
+        AsyncTask get_return_object() { return AsyncTask(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+ * @class EventLoop
+ * @brief A minimal single-threaded loop of coroutines that are ready to run.
+ *
+ * Coroutines reschedule themselves with co_await loop.schedule(), and run()
+ * resumes them one by one until none are left.
+ */
+class EventLoop
+{
+private:
+    std::deque<std::coroutine_handle<>> ready; ///< Coroutines waiting for their turn
+
+public:
+    /**
+     * @brief Awaitable returned by schedule that moves the coroutine to the back of the loop.
+     */
+    struct ScheduleAwaiter {
+        EventLoop* loop;  ///< The loop to which the coroutine is posted
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { loop->post(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Adds a suspended coroutine to the back of the loop.
+     *
+     * @param handle The coroutine to be resumed later.
+     */
+    void post(std::coroutine_handle<> handle);
+
+    /**
+     * @brief Suspends the calling coroutine and resumes it on a later turn of the loop.
+     *
+     * @return ScheduleAwaiter The awaitable to co_await.
+     */
+    ScheduleAwaiter schedule();
+
+    /**
+     * @brief Resumes ready coroutines until none are left.
+     *
+     * @return int The number of coroutines that were resumed.
+     */
+    int run();
+
+    /**
+     * @brief Checks if any coroutine is ready to run.
+     *
+     * @return True if no coroutine is ready, false otherwise.
+     */
+    bool isEmpty() const;
+};
@@ -0,0 +1,288 @@
+#include "ExternalSort.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Writes a whole buffer to a file descriptor.
+ *
+ * @param fd The file descriptor to write to.
+ * @param data The data to be written.
+ * @param bytes The number of bytes to be written.
+ * @return bool True if every byte was written, false otherwise.
+ */
+static bool writeAll(int fd, const void* data, size_t bytes) {
+    const char* current = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, current, bytes);
+        if (written < 0) {
+            return false;
+        }
+        current += written;
+        bytes -= size_t(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Maps a whole file read-only with sequential readahead.
+ *
+ * @param path The path of the file to be mapped.
+ * @param data Set to the start of the mapping, nullptr for empty files.
+ * @param bytes Set to the size of the file.
+ * @return bool True if the file was mapped or is empty, false if it cannot be read.
+ */
+static bool mapFile(const std::string& path, const int*& data, size_t& bytes) {
+    data = nullptr;
+    bytes = 0;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    bytes = size_t(info.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after closing, which keeps thousands of runs
+    // open without running into the descriptor limit.
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        bytes = 0;
+        return false;
+    }
+
+    ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+    data = static_cast<const int*>(mapping);
+    return true;
+}
+
+/**
+ * @brief Returns the throughput in GB/s for a number of bytes and seconds.
+ *
+ * @param bytes The number of bytes processed.
+ * @param seconds The time it took.
+ * @return double The throughput in GB/s.
+ */
+static double throughput(size_t bytes, double seconds) {
+    return seconds > 0.0 ? double(bytes) / seconds / 1e9 : 0.0;
+}
+
+/**
+ * @brief Constructs an external sorter.
+ *
+ * @param runElements The number of elements sorted in memory for each run.
+ * @param bufferElements The number of elements buffered before each write.
+ * @param tempDir The directory in which the runs are spilled.
+ */
+ExternalSort::ExternalSort(size_t runElements, size_t bufferElements, const std::string& tempDir)
+    : runLength(runElements > 0 ? runElements : 1),
+    bufferLength(bufferElements > 0 ? bufferElements : 1),
+    tempDirectory(tempDir) {}
+
+/**
+ * @brief Destroys the sorter and deletes any runs left on disk.
+ */
+ExternalSort::~ExternalSort() {
+    this->removeRuns();
+}
+
+/**
+ * @brief Splits the input into sorted runs and spills them to disk.
+ *
+ * @param inputPath The path of the file to be sorted.
+ * @return bool True if all runs were written, false otherwise.
+ */
+bool ExternalSort::createRuns(const std::string& inputPath) {
+    size_t bytes = 0;
+    const int* input = nullptr;
+    if (!mapFile(inputPath, input, bytes)) {
+        std::cout << "Creating the runs failed, because the input file " << inputPath << " cannot be mapped.\n";
+        return false;
+    }
+    if (input == nullptr) {
+        return true;
+    }
+
+    size_t count = bytes / sizeof(int);
+    std::vector<int> run;
+    run.reserve(std::min(count, this->runLength));
+    size_t pageSize = size_t(::sysconf(_SC_PAGESIZE));
+
+    bool success = true;
+    for (size_t start = 0; start < count && success; start += this->runLength) {
+        size_t end = std::min(count, start + this->runLength);
+        run.assign(input + start, input + end);
+        std::sort(run.begin(), run.end());
+
+        // The pages of this run will not be read again.
+        size_t doneBytes = (end * sizeof(int)) / pageSize * pageSize;
+        ::madvise(const_cast<int*>(input), doneBytes, MADV_DONTNEED);
+
+        // mkstemp picks a name no other sort in the same directory can take.
+        std::string path = this->tempDirectory + "/run_XXXXXX";
+        int fd = ::mkstemp(&path[0]);
+        if (fd < 0) {
+            std::cout << "Creating a run in " << this->tempDirectory << " failed.\n";
+            success = false;
+            break;
+        }
+        this->runFiles.push_back(path);
+        success = writeAll(fd, run.data(), run.size() * sizeof(int));
+        ::close(fd);
+    }
+
+    ::munmap(const_cast<int*>(input), bytes);
+    return success;
+}
+
+/**
+ * @brief Merges the sorted runs into the output file.
+ *
+ * @param outputPath The path of the sorted output file.
+ * @return bool True if the output was written, false otherwise.
+ */
+bool ExternalSort::mergeRuns(const std::string& outputPath) {
+    int out = ::open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) {
+        std::cout << "Creating the output file " << outputPath << " failed.\n";
+        return false;
+    }
+
+    size_t runCount = this->runFiles.size();
+    std::vector<const int*> position(runCount, nullptr);
+    std::vector<const int*> end(runCount, nullptr);
+    std::vector<size_t> mappedBytes(runCount, 0);
+
+    FibonacciHeap heap;
+    bool success = true;
+    for (size_t i = 0; i < runCount; i++) {
+        const int* run = nullptr;
+        if (!mapFile(this->runFiles[i], run, mappedBytes[i])) {
+            std::cout << "Merging failed, because the run " << this->runFiles[i] << " cannot be mapped.\n";
+            success = false;
+            break;
+        }
+        if (run == nullptr) {
+            continue;
+        }
+        position[i] = run;
+        end[i] = run + mappedBytes[i] / sizeof(int);
+        heap.insert(*position[i], int(i));
+        position[i] += 1;
+    }
+
+    std::vector<int> buffer;
+    buffer.reserve(this->bufferLength);
+    bool mapped = success;
+
+    while (!heap.isEmpty() && success) {
+        Node* head = heap.extractMin();
+        int run = head->getId();
+
+        // The key is the last element taken from the run, which is copied
+        // from the run itself instead of narrowing the 64-bit key again.
+        buffer.push_back(position[run][-1]);
+
+        // Elements that are not above the smallest head of the other runs go
+        // straight to the output, so sorted stretches and the last run skip
+        // the heap.
+        while (position[run] != end[run] && buffer.size() < this->bufferLength
+            && (heap.isEmpty() || *position[run] <= heap.getMinValue())) {
+            buffer.push_back(*position[run]);
+            position[run] += 1;
+        }
+
+        // Every run keeps one node for its whole merge, so no record pays
+        // for an allocation.
+        if (position[run] != end[run]) {
+            head->setKey(*position[run]);
+            heap.insertNode(head);
+            position[run] += 1;
+        }
+        else {
+            delete head;
+        }
+
+        if (buffer.size() == this->bufferLength) {
+            success = writeAll(out, buffer.data(), buffer.size() * sizeof(int));
+            buffer.clear();
+        }
+    }
+
+    if (success && !buffer.empty()) {
+        success = writeAll(out, buffer.data(), buffer.size() * sizeof(int));
+    }
+    if (mapped && !success) {
+        std::cout << "Writing the output file " << outputPath << " failed.\n";
+    }
+
+    for (size_t i = 0; i < runCount; i++) {
+        if (end[i] != nullptr) {
+            ::munmap(const_cast<int*>(end[i] - mappedBytes[i] / sizeof(int)), mappedBytes[i]);
+        }
+    }
+    ::close(out);
+    return success;
+}
+
+/**
+ * @brief Deletes the runs created by the first phase.
+ */
+void ExternalSort::removeRuns() {
+    for (const std::string& path : this->runFiles) {
+        std::remove(path.c_str());
+    }
+    this->runFiles.clear();
+}
+
+/**
+ * @brief Sorts the integers of the input file into the output file.
+ *
+ * @param inputPath The path of the file to be sorted.
+ * @param outputPath The path of the sorted output file.
+ * @return bool True if the sort succeeded, false otherwise.
+ */
+bool ExternalSort::sort(const std::string& inputPath, const std::string& outputPath) {
+    this->removeRuns();
+
+    struct stat info;
+    if (::stat(inputPath.c_str(), &info) != 0) {
+        std::cout << "Sorting failed, because the input file " << inputPath << " cannot be read.\n";
+        return false;
+    }
+    size_t bytes = size_t(info.st_size) / sizeof(int) * sizeof(int);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!this->createRuns(inputPath)) {
+        this->removeRuns();
+        return false;
+    }
+    auto split = std::chrono::steady_clock::now();
+    bool success = this->mergeRuns(outputPath);
+    auto finish = std::chrono::steady_clock::now();
+    this->removeRuns();
+
+    if (success) {
+        double runSeconds = std::chrono::duration<double>(split - start).count();
+        double mergeSeconds = std::chrono::duration<double>(finish - split).count();
+        std::cout << "Run generation: " << throughput(bytes, runSeconds) << " GB/s\n";
+        std::cout << "Merge: " << throughput(bytes, mergeSeconds) << " GB/s\n";
+        std::cout << "Total: " << throughput(bytes, runSeconds + mergeSeconds) << " GB/s\n";
+    }
+    return success;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class ExternalSort
+ * @brief Sorts binary files of integers that do not fit in memory.
+ *
+ * The input is a raw file of native 32-bit integers. Sorting happens in two
+ * phases: the input is split into sorted runs that are spilled to disk, and the
+ * runs are then merged with a Fibonacci Heap holding the head element of every
+ * run. Runs are read through memory mappings with sequential readahead and the
+ * output is written in large buffered blocks.
+ */
+class ExternalSort
+{
+private:
+    size_t runLength;                  ///< Number of elements in each sorted run
+    size_t bufferLength;               ///< Number of elements buffered before each write
+    std::string tempDirectory;         ///< Directory in which the runs are spilled
+    std::vector<std::string> runFiles; ///< Paths of the runs created by the first phase
+
+    /**
+     * @brief Splits the input into sorted runs and spills them to disk.
+     *
+     * @param inputPath The path of the file to be sorted.
+     * @return bool True if all runs were written, false otherwise.
+     */
+    bool createRuns(const std::string& inputPath);
+
+    /**
+     * @brief Merges the sorted runs into the output file.
+     *
+     * The head element of every run is kept in a Fibonacci Heap, with the run
+     * index stored as the id of its node.
+     *
+     * @param outputPath The path of the sorted output file.
+     * @return bool True if the output was written, false otherwise.
+     */
+    bool mergeRuns(const std::string& outputPath);
+
+    /**
+     * @brief Deletes the runs created by the first phase.
+     */
+    void removeRuns();
+
+public:
+    /**
+     * @brief Constructs an external sorter.
+     *
+     * @param runElements The number of elements sorted in memory for each run.
+     * @param bufferElements The number of elements buffered before each write.
+     * @param tempDir The directory in which the runs are spilled.
+     */
+    ExternalSort(size_t runElements = size_t(1) << 24,
+        size_t bufferElements = size_t(1) << 20,
+        const std::string& tempDir = ".");
+
+    /**
+     * @brief Destroys the sorter and deletes any runs left on disk.
+     */
+    ~ExternalSort();
+
+    /**
+     * @brief Sorts the integers of the input file into the output file.
+     *
+     * The throughput of both phases is reported on the standard output.
+     *
+     * @param inputPath The path of the file to be sorted.
+     * @param outputPath The path of the sorted output file.
+     * @return bool True if the sort succeeded, false otherwise.
+     */
+    bool sort(const std::string& inputPath, const std::string& outputPath);
+};
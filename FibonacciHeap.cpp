@@ -1,15 +1,19 @@
 #include "FibonacciHeap.h"
-#include <cmath>
-#include <unordered_map>
+#include "HeapProfiler.h"
+#include "HeapValidator.h"
 #include <iostream>
+#include <utility>
 
 /**
  * @brief Restructures the heap after an operation to maintain the heap property.
  */
 void FibonacciHeap::consolidate() {
-    int maxDegree = int(std::log(this->getSize()) / std::log(2)) + 1;
-
-    std::unordered_map<int, Node*> degreeTable;
+    // The degree of any node is bounded by log_phi(n) <= 1.4405 * log2(n),
+    // which stays below 93 for any 64-bit size, so the table fits on the
+    // stack and consolidating allocates nothing.
+    const int maxDegree = 96;
+    Node* degreeTable[maxDegree] = {};
+    int highest = 0;
 
     Node* startNode = this->getMinNode();
     Node* currentNode = startNode;
@@ -18,25 +22,27 @@ void FibonacciHeap::consolidate() {
         Node* x = currentNode;
         int d = x->getDegree();
         Node* nextNode = currentNode->getRight();
+        x->setParent(nullptr);
 
-        while (degreeTable.find(d) != degreeTable.end()) {
+        while (degreeTable[d] != nullptr) {
             Node* y = degreeTable[d];
             if (x->getKey() > y->getKey()) {
                 std::swap(x, y);
             }
-            x->link(y);
-            degreeTable.erase(d);
+            this->link(y, x);
+            degreeTable[d] = nullptr;
             d += 1;
         }
         degreeTable[d] = x;
+        highest = d > highest ? d : highest;
         currentNode = nextNode;
 
     } while (currentNode != startNode);
 
     this->setMinNode(nullptr);
 
-    for (const auto& entry : degreeTable) {
-        Node* node = entry.second;
+    for (int d = 0; d <= highest; d++) {
+        Node* node = degreeTable[d];
         if (node != nullptr) {
             if (this->getMinNode() == nullptr) {
                 this->setMinNode(node);
@@ -90,6 +96,7 @@ void FibonacciHeap::link(Node* y, Node* x) {
  * @param y The parent node from which x is to be cut.
  */
 void FibonacciHeap::cut(Node* x, Node* y) {
+    FIBHEAP_PROFILE_CUT();
     y->removeChild(x);
     this->getMinNode()->addSibling(x);
     x->setMark(false);
@@ -138,9 +145,29 @@ FibonacciHeap::~FibonacciHeap() {
  * @brief Inserts a new node with the given value into the heap.
  *
  * @param value The value of the new node.
+ * @param id Optional identifier stored in the new node (-1 if unused).
+ * @return Node* The newly inserted node.
  */
-void FibonacciHeap::insert(int value) {
-    Node* newNode = new Node(value);
+Node* FibonacciHeap::insert(long long value, int id) {
+    FIBHEAP_PROFILE_SCOPE(opInsert);
+    Node* newNode = new Node(value, id);
+    this->insertNode(newNode);
+    return newNode;
+}
+
+/**
+ * @brief Adds a node that is not in any heap to the root list.
+ *
+ * @param newNode The node to be added.
+ */
+void FibonacciHeap::insertNode(Node* newNode) {
+    FIBHEAP_PROFILE_SCOPE(opInsert);
+    newNode->setParent(nullptr);
+    newNode->setChild(nullptr);
+    newNode->setLeft(newNode);
+    newNode->setRight(newNode);
+    newNode->setDegree(0);
+    newNode->setMark(false);
 
     if (this->minNode == nullptr) {
         this->minNode = newNode;
@@ -157,6 +184,7 @@ void FibonacciHeap::insert(int value) {
     }
 
     this->numNodes += 1;
+    FIBHEAP_CHECK(this, "insert");
 }
 
 /**
@@ -165,6 +193,7 @@ void FibonacciHeap::insert(int value) {
  * @param otherHeap The other Fibonacci heap to be merged with this one.
  */
 void FibonacciHeap::unionHeap(FibonacciHeap* otherHeap) {
+    FIBHEAP_PROFILE_SCOPE(opUnionHeap);
     if (otherHeap == nullptr || otherHeap->isEmpty()) {
         return;
     }
@@ -193,6 +222,7 @@ void FibonacciHeap::unionHeap(FibonacciHeap* otherHeap) {
     otherHeap->minNode = nullptr;
     otherHeap->numNodes = 0;
     delete otherHeap;
+    FIBHEAP_CHECK(this, "unionHeap");
 }
 
 /**
@@ -201,19 +231,21 @@ void FibonacciHeap::unionHeap(FibonacciHeap* otherHeap) {
  * @return Node* The node with the minimum key.
  */
 Node* FibonacciHeap::extractMin() {
+    FIBHEAP_PROFILE_SCOPE(opExtractMin);
     Node* zNode = this->getMinNode();
     if (zNode != nullptr) {
         Node* zChild = zNode->getChild();
-        while (zChild != nullptr ) {
-            Node* nextChild = zChild->getRight();
-            zNode->removeChild(zChild);
-            zNode->addSibling(zChild);
-            
-            if (zChild == nextChild)
-            {
-                break;
-            }
-            zChild = nextChild;
+        if (zChild != nullptr) {
+            // Splice the whole child ring into the root ring at once; consolidate
+            // clears the parent of every root it walks over.
+            Node* lastChild = zChild->getLeft();
+            Node* after = zNode->getRight();
+            zNode->setRight(zChild);
+            zChild->setLeft(zNode);
+            lastChild->setRight(after);
+            after->setLeft(lastChild);
+            zNode->setChild(nullptr);
+            zNode->setDegree(0);
         }
 
         Node* leftSibling = zNode->getLeft();
@@ -230,6 +262,7 @@ Node* FibonacciHeap::extractMin() {
         }
         this->decreaseDegree();
     }
+    FIBHEAP_CHECK(this, "extractMin");
     return zNode;
 }
 
@@ -239,7 +272,8 @@ Node* FibonacciHeap::extractMin() {
  * @param x The node whose key is to be decreased.
  * @param newKey The new, smaller key value.
  */
-void FibonacciHeap::decreaseKey(Node* x, int newKey) {
+void FibonacciHeap::decreaseKey(Node* x, long long newKey) {
+    FIBHEAP_PROFILE_SCOPE(opDecreaseKey);
     if (newKey > x->getKey()) {
         std::cout << "Decreasing the key failed, because the new key is greater than the current key.\n";
         return;
@@ -256,21 +290,80 @@ void FibonacciHeap::decreaseKey(Node* x, int newKey) {
     if (x->getKey() < this->getMinNode()->getKey()) {
         this->setMinNode(x);
     }
+    FIBHEAP_CHECK(this, "decreaseKey");
+}
+
+/**
+ * @brief Increases the key of a given node in place.
+ *
+ * @param x The node whose key is to be increased.
+ * @param newKey The new, larger key value.
+ */
+void FibonacciHeap::increaseKey(Node* x, long long newKey) {
+    FIBHEAP_PROFILE_SCOPE(opIncreaseKey);
+    if (newKey < x->getKey()) {
+        std::cout << "Increasing the key failed, because the new key is smaller than the current key.\n";
+        return;
+    }
+
+    Node* xParent = x->getParent();
+    if (xParent != nullptr) {
+        this->cut(x, xParent);
+        this->cascadingCut(xParent);
+    }
+
+    // The children may end up smaller than x, so they move to the root list.
+    Node* xChild = x->getChild();
+    while (xChild != nullptr) {
+        Node* nextChild = xChild->getRight();
+        x->removeChild(xChild);
+        x->addSibling(xChild);
+        xChild->setMark(false);
+
+        if (xChild == nextChild) {
+            break;
+        }
+        xChild = nextChild;
+    }
+
+    x->setKey(newKey);
+    x->setMark(false);
+    if (x == this->getMinNode()) {
+        this->consolidate();
+    }
+    FIBHEAP_CHECK(this, "increaseKey");
 }
 
 /**
- * @brief Deletes a given node by decreasing the key to -1 assuming
- * all values are positive.
+ * @brief Deletes a given node by moving it to the root list and extracting
+ * it as if it was the minimum.
  *
  * @param x The node that will be deleted.
  */
 void FibonacciHeap::deleteNode(Node* x)
 {
-    this->decreaseKey(x, -1);
-    delete this->extractMin();
+    FIBHEAP_PROFILE_SCOPE(opDeleteNode);
+    delete this->removeNode(x);
+    FIBHEAP_CHECK(this, "deleteNode");
     return;
 }
 
+/**
+ * @brief Removes a node from the heap without deleting it.
+ *
+ * @param x The node to be removed.
+ * @return Node* The removed node.
+ */
+Node* FibonacciHeap::removeNode(Node* x) {
+    Node* xParent = x->getParent();
+    if (xParent != nullptr) {
+        this->cut(x, xParent);
+        this->cascadingCut(xParent);
+    }
+    this->setMinNode(x);
+    return this->extractMin();
+}
+
 /**
  * @brief Checks if the heap is empty.
  *
@@ -283,18 +376,18 @@ bool FibonacciHeap::isEmpty() const {
 /**
  * @brief Returns the minimum value in the heap.
  *
- * @return int The minimum value in the heap.
+ * @return long long The minimum value in the heap.
  */
-int FibonacciHeap::getMinValue() const {
+long long FibonacciHeap::getMinValue() const {
     return this->getMinNode()->getKey();
 }
 
 /**
  * @brief Returns the number of nodes in the heap.
  *
- * @return int The number of nodes in the heap.
+ * @return long long The number of nodes in the heap.
  */
-int FibonacciHeap::getSize() const {
+long long FibonacciHeap::getSize() const {
     return this->numNodes;
 }
 
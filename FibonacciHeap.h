@@ -11,9 +11,14 @@
  */
 class FibonacciHeap
 {
+    friend class HeapSnapshot;
+    friend class HeapValidator;
+    friend class IndexedFibonacciHeap;
+    friend class Simulation;
+
 private:
     Node* minNode;    ///< Pointer to the minimum node in the heap
-    int numNodes;     ///< Total number of nodes in the heap
+    long long numNodes; ///< Total number of nodes in the heap
 
     /**
      * @brief Restructures the heap after an operation to maintain the heap property.
@@ -55,6 +60,14 @@ private:
      */
     void cascadingCut(Node* y);
 
+    /**
+     * @brief Removes a node from the heap without deleting it.
+     *
+     * @param x The node to be removed.
+     * @return Node* The removed node.
+     */
+    Node* removeNode(Node* x);
+
     /**
      * @brief Decreases the degree of the heap.
      *
@@ -96,10 +109,25 @@ public:
      * @brief Inserts a new node with the given value into the heap.
      *
      * This method creates a new node with the specified value and adds it to the heap.
+     * The returned node can be used as a handle for decreaseKey and deleteNode.
      *
      * @param value The value of the new node.
+     * @param id Optional identifier stored in the new node (-1 if unused).
+     * @return Node* The newly inserted node.
      */
-    void insert(int value);
+    Node* insert(long long value, int id = -1);
+
+    /**
+     * @brief Adds a node that is not in any heap to the root list.
+     *
+     * The node keeps its key and id; its links, degree and mark are reset.
+     * This lets a caller reuse a node returned by extractMin with a new key
+     * instead of deleting it and allocating another one with insert. The
+     * heap deletes the node when it is destroyed, unless it is removed first.
+     *
+     * @param newNode The node to be added.
+     */
+    void insertNode(Node* newNode);
 
     /**
      * @brief Removes and returns the node with the minimum key.
@@ -119,7 +147,20 @@ public:
      * @param x The node whose key is to be decreased.
      * @param newKey The new, smaller key value.
      */
-    void decreaseKey(Node* x, int newKey);
+    void decreaseKey(Node* x, long long newKey);
+
+    /**
+     * @brief Increases the key of a given node in place.
+     *
+     * The node is cut from its parent and its children become roots, since
+     * they may now be smaller than it. The node itself stays in the heap, so
+     * its handle remains valid. If it was the minimum, the roots are
+     * consolidated to find the new minimum.
+     *
+     * @param x The node whose key is to be increased.
+     * @param newKey The new, larger key value.
+     */
+    void increaseKey(Node* x, long long newKey);
 
     /**
      * @brief Deletes a given node from the heap.
@@ -153,18 +194,18 @@ public:
      *
      * This method retrieves the value of the node with the smallest key.
      *
-     * @return int The minimum value in the heap.
+     * @return long long The minimum value in the heap.
      */
-    int getMinValue() const;
+    long long getMinValue() const;
 
     /**
      * @brief Returns the number of nodes in the heap.
      *
      * This method provides the total count of nodes currently in the heap.
      *
-     * @return int The number of nodes in the heap.
+     * @return long long The number of nodes in the heap.
      */
-    int getSize() const;
+    long long getSize() const;
 
     /**
      * @brief Gets the pointer to the minimum node in the heap.
@@ -0,0 +1,495 @@
+#include "HeapProfiler.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+/**
+ * @brief The profiling state of one thread.
+ */
+struct ThreadProfile {
+    int depth = 0;            ///< Number of measured operations currently running
+    uint64_t cuts = 0;        ///< Cuts made on this thread so far
+    uint64_t calls = 0;       ///< Outermost operations measured on this thread
+    int counterGroup = -1;    ///< Leader of the perf_event group, -1 if not opened
+    int counterFds[HeapProfiler::counterCount] = { -1, -1, -1 }; ///< Every counter of the group
+    bool countersFailed = false; ///< Whether opening the counters failed
+
+    /**
+     * @brief Closes the hardware counters of the thread.
+     */
+    ~ThreadProfile() {
+#if defined(__linux__)
+        for (int fd : this->counterFds) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+#endif
+    }
+};
+
+static thread_local ThreadProfile threadProfile;
+
+/**
+ * @brief Opens the hardware counters of the calling thread.
+ *
+ * @return bool True if the counters can be read, false otherwise.
+ */
+static bool openCounters() {
+    if (threadProfile.counterGroup != -1) {
+        return true;
+    }
+    if (threadProfile.countersFailed) {
+        return false;
+    }
+
+#if defined(__linux__)
+    const uint64_t configs[HeapProfiler::counterCount] = {
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_INSTRUCTIONS
+    };
+    for (int i = 0; i < HeapProfiler::counterCount; i++) {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = configs[i];
+        attributes.read_format = PERF_FORMAT_GROUP;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        int group = i == 0 ? -1 : threadProfile.counterFds[0];
+        int fd = int(syscall(SYS_perf_event_open, &attributes, 0, -1, group, 0));
+        if (fd == -1) {
+            std::cout << "Opening the hardware counters failed, because perf_event_open returned an error ("
+                << std::strerror(errno) << ").\n";
+            for (int j = 0; j < i; j++) {
+                close(threadProfile.counterFds[j]);
+                threadProfile.counterFds[j] = -1;
+            }
+            threadProfile.countersFailed = true;
+            return false;
+        }
+        threadProfile.counterFds[i] = fd;
+    }
+    threadProfile.counterGroup = threadProfile.counterFds[0];
+    ioctl(threadProfile.counterGroup, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(threadProfile.counterGroup, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    std::cout << "Opening the hardware counters failed, because they are only supported on Linux.\n";
+    threadProfile.countersFailed = true;
+    return false;
+#endif
+}
+
+/**
+ * @brief Reads every hardware counter of the calling thread with one system call.
+ *
+ * @param values The array receiving the counter values.
+ * @return bool True if the counters were read, false otherwise.
+ */
+static bool readCounters(uint64_t* values) {
+#if defined(__linux__)
+    uint64_t buffer[1 + HeapProfiler::counterCount];
+    if (read(threadProfile.counterGroup, buffer, sizeof(buffer)) != ssize_t(sizeof(buffer))) {
+        return false;
+    }
+    for (int i = 0; i < HeapProfiler::counterCount; i++) {
+        values[i] = buffer[1 + i];
+    }
+    return true;
+#else
+    (void)values;
+    return false;
+#endif
+}
+
+/**
+ * @brief Constructs an empty histogram.
+ */
+LatencyHistogram::LatencyHistogram() {
+    this->reset();
+}
+
+/**
+ * @brief Returns the bucket of a value.
+ *
+ * @param value The value.
+ * @return int The index of its bucket.
+ */
+int LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < (uint64_t(1) << subBucketBits)) {
+        return int(value);
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent > maxExponent) {
+        return bucketCount - 1;
+    }
+    int subBucket = int(value >> (exponent - subBucketBits)) & ((1 << subBucketBits) - 1);
+    return ((exponent - subBucketBits + 1) << subBucketBits) + subBucket;
+}
+
+/**
+ * @brief Returns the largest value that falls into a bucket.
+ *
+ * @param bucket The index of the bucket.
+ * @return uint64_t The upper bound of the bucket.
+ */
+uint64_t LatencyHistogram::upperBound(int bucket) {
+    if (bucket < (1 << subBucketBits)) {
+        return uint64_t(bucket);
+    }
+    int exponent = (bucket >> subBucketBits) + subBucketBits - 1;
+    uint64_t subBucket = uint64_t(bucket & ((1 << subBucketBits) - 1));
+    uint64_t lower = (uint64_t(1) << exponent) + (subBucket << (exponent - subBucketBits));
+    return lower + (uint64_t(1) << (exponent - subBucketBits)) - 1;
+}
+
+/**
+ * @brief Adds a value to the histogram.
+ *
+ * @param value The value to be recorded.
+ */
+void LatencyHistogram::record(uint64_t value) {
+    this->buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+    this->total.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = this->maximum.load(std::memory_order_relaxed);
+    while (value > current
+        && !this->maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Removes every recorded value.
+ */
+void LatencyHistogram::reset() {
+    for (int i = 0; i < bucketCount; i++) {
+        this->buckets[i].store(0, std::memory_order_relaxed);
+    }
+    this->count.store(0, std::memory_order_relaxed);
+    this->total.store(0, std::memory_order_relaxed);
+    this->maximum.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the value below which a fraction of the recorded values lie.
+ *
+ * @param fraction The fraction, between 0 and 1.
+ * @return uint64_t The upper bound of the bucket holding the percentile, 0 if empty.
+ */
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    uint64_t recorded = this->getCount();
+    if (recorded == 0) {
+        return 0;
+    }
+
+    uint64_t rank = uint64_t(fraction * double(recorded) + 0.5);
+    rank = rank < 1 ? 1 : (rank > recorded ? recorded : rank);
+    uint64_t seen = 0;
+    for (int i = 0; i < bucketCount; i++) {
+        seen += this->getBucket(i);
+        if (seen >= rank) {
+            // The top bucket is open ended, and no bucket reaches past the maximum.
+            uint64_t bound = upperBound(i);
+            return bound < this->getMax() ? bound : this->getMax();
+        }
+    }
+    return this->getMax();
+}
+
+/**
+ * @brief Returns the number of values in a bucket.
+ *
+ * @param bucket The index of the bucket.
+ * @return uint64_t The number of values.
+ */
+uint64_t LatencyHistogram::getBucket(int bucket) const {
+    return this->buckets[bucket].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the number of recorded values.
+ *
+ * @return uint64_t The number of values.
+ */
+uint64_t LatencyHistogram::getCount() const {
+    return this->count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the mean of the recorded values.
+ *
+ * @return double The mean, 0 if empty.
+ */
+double LatencyHistogram::getMean() const {
+    uint64_t recorded = this->getCount();
+    return recorded == 0 ? 0.0 : double(this->total.load(std::memory_order_relaxed)) / double(recorded);
+}
+
+/**
+ * @brief Returns the largest recorded value.
+ *
+ * @return uint64_t The maximum, 0 if empty.
+ */
+uint64_t LatencyHistogram::getMax() const {
+    return this->maximum.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Constructs a profiler with counters disabled.
+ */
+HeapProfiler::HeapProfiler() : samplePeriod(0) {
+    this->reset();
+}
+
+/**
+ * @brief Returns the profiler shared by every heap.
+ *
+ * @return HeapProfiler& The profiler.
+ */
+HeapProfiler& HeapProfiler::instance() {
+    static HeapProfiler profiler;
+    return profiler;
+}
+
+/**
+ * @brief Returns the name of an operation.
+ *
+ * @param operation The operation.
+ * @return const char* Its name, as used in the reports.
+ */
+const char* HeapProfiler::operationName(HeapOperation operation) {
+    switch (operation) {
+    case opInsert: return "insert";
+    case opExtractMin: return "extractMin";
+    case opDecreaseKey: return "decreaseKey";
+    case opDeleteNode: return "deleteNode";
+    case opUnionHeap: return "unionHeap";
+    case opIncreaseKey: return "increaseKey";
+    default: return "unknown";
+    }
+}
+
+/**
+ * @brief Reads hardware counters around every n-th operation of each thread.
+ *
+ * @param period The sampling period, 0 to stop reading counters.
+ */
+void HeapProfiler::setCounterSampling(int period) {
+    this->samplePeriod.store(period > 0 ? period : 0);
+}
+
+/**
+ * @brief Returns the hardware counter sampling period.
+ *
+ * @return int The period, 0 when counters are not read.
+ */
+int HeapProfiler::getCounterSampling() const {
+    return this->samplePeriod.load();
+}
+
+/**
+ * @brief Records one completed operation.
+ *
+ * @param operation The operation.
+ * @param nanoseconds Its latency.
+ * @param cuts The number of cuts it made.
+ * @param counters The counter deltas, nullptr if the call was not sampled.
+ */
+void HeapProfiler::record(HeapOperation operation, uint64_t nanoseconds, uint64_t cuts, const uint64_t* counters) {
+    OperationStats& entry = this->stats[operation];
+    entry.latency.record(nanoseconds);
+    entry.cuts.record(cuts);
+    if (counters != nullptr) {
+        entry.samples.fetch_add(1, std::memory_order_relaxed);
+        for (int i = 0; i < counterCount; i++) {
+            entry.counters[i].fetch_add(counters[i], std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Removes everything recorded so far.
+ */
+void HeapProfiler::reset() {
+    for (OperationStats& entry : this->stats) {
+        entry.latency.reset();
+        entry.cuts.reset();
+        entry.samples.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < counterCount; i++) {
+            entry.counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Returns the latency histogram of an operation.
+ *
+ * @param operation The operation.
+ * @return const LatencyHistogram& The histogram in nanoseconds.
+ */
+const LatencyHistogram& HeapProfiler::getLatency(HeapOperation operation) const {
+    return this->stats[operation].latency;
+}
+
+/**
+ * @brief Returns the histogram of cuts per call of an operation.
+ *
+ * @param operation The operation.
+ * @return const LatencyHistogram& The histogram.
+ */
+const LatencyHistogram& HeapProfiler::getCuts(HeapOperation operation) const {
+    return this->stats[operation].cuts;
+}
+
+/**
+ * @brief Exports every statistic, including the non-empty buckets, as JSON.
+ *
+ * @return std::string The JSON document.
+ */
+std::string HeapProfiler::toJson() const {
+    static const char* counterNames[counterCount] = { "cache_misses", "branch_misses", "instructions" };
+
+    std::ostringstream out;
+    out << "{\n  \"counter_sampling\": " << this->getCounterSampling() << ",\n  \"operations\": [";
+    for (int op = 0; op < opCount; op++) {
+        const OperationStats& entry = this->stats[op];
+        const LatencyHistogram& latency = entry.latency;
+        out << (op == 0 ? "\n" : ",\n") << "    {\n"
+            << "      \"name\": \"" << operationName(HeapOperation(op)) << "\",\n"
+            << "      \"count\": " << latency.getCount() << ",\n"
+            << "      \"latency_ns\": { \"mean\": " << latency.getMean()
+            << ", \"p50\": " << latency.percentile(0.5)
+            << ", \"p90\": " << latency.percentile(0.9)
+            << ", \"p99\": " << latency.percentile(0.99)
+            << ", \"p999\": " << latency.percentile(0.999)
+            << ", \"p9999\": " << latency.percentile(0.9999)
+            << ", \"max\": " << latency.getMax() << " },\n"
+            << "      \"cuts\": { \"mean\": " << entry.cuts.getMean()
+            << ", \"p99\": " << entry.cuts.percentile(0.99)
+            << ", \"max\": " << entry.cuts.getMax() << " },\n";
+
+        uint64_t samples = entry.samples.load(std::memory_order_relaxed);
+        out << "      \"counters\": { \"samples\": " << samples;
+        for (int i = 0; i < counterCount; i++) {
+            double perCall = samples == 0 ? 0.0
+                : double(entry.counters[i].load(std::memory_order_relaxed)) / double(samples);
+            out << ", \"" << counterNames[i] << "_per_call\": " << perCall;
+        }
+        out << " },\n      \"latency_buckets\": [";
+
+        bool first = true;
+        for (int i = 0; i < LatencyHistogram::bucketCount; i++) {
+            uint64_t bucket = latency.getBucket(i);
+            if (bucket != 0) {
+                out << (first ? "" : ", ") << "[" << LatencyHistogram::upperBound(i) << ", " << bucket << "]";
+                first = false;
+            }
+        }
+        out << "]\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+/**
+ * @brief Formats the statistics as a text table with one line per operation.
+ *
+ * @return std::string The table.
+ */
+std::string HeapProfiler::toTable() const {
+    std::ostringstream out;
+    out << std::left << std::setw(12) << "operation" << std::right
+        << std::setw(12) << "count" << std::setw(10) << "mean ns"
+        << std::setw(9) << "p50" << std::setw(9) << "p90" << std::setw(9) << "p99"
+        << std::setw(9) << "p99.9" << std::setw(10) << "max"
+        << std::setw(10) << "cuts p99" << std::setw(10) << "cuts max"
+        << std::setw(12) << "cache miss" << std::setw(12) << "branch miss"
+        << std::setw(12) << "instr" << "\n";
+
+    out << std::fixed << std::setprecision(1);
+    for (int op = 0; op < opCount; op++) {
+        const OperationStats& entry = this->stats[op];
+        const LatencyHistogram& latency = entry.latency;
+        out << std::left << std::setw(12) << operationName(HeapOperation(op)) << std::right
+            << std::setw(12) << latency.getCount() << std::setw(10) << latency.getMean()
+            << std::setw(9) << latency.percentile(0.5) << std::setw(9) << latency.percentile(0.9)
+            << std::setw(9) << latency.percentile(0.99) << std::setw(9) << latency.percentile(0.999)
+            << std::setw(10) << latency.getMax()
+            << std::setw(10) << entry.cuts.percentile(0.99) << std::setw(10) << entry.cuts.getMax();
+
+        uint64_t samples = entry.samples.load(std::memory_order_relaxed);
+        for (int i = 0; i < counterCount; i++) {
+            if (samples == 0) {
+                out << std::setw(12) << "-";
+            }
+            else {
+                out << std::setw(12) << double(entry.counters[i].load(std::memory_order_relaxed)) / double(samples);
+            }
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+/**
+ * @brief Counts one cut made by the operation running on this thread.
+ */
+void HeapProfiler::countCut() {
+    threadProfile.cuts += 1;
+}
+
+/**
+ * @brief Starts measuring an operation.
+ *
+ * @param op The operation.
+ */
+HeapProfileScope::HeapProfileScope(HeapOperation op)
+    : operation(op), outermost(threadProfile.depth == 0), sampled(false), startCuts(threadProfile.cuts) {
+    threadProfile.depth += 1;
+    if (!this->outermost) {
+        return;
+    }
+
+    int period = HeapProfiler::instance().getCounterSampling();
+    threadProfile.calls += 1;
+    if (period > 0 && threadProfile.calls % uint64_t(period) == 0 && openCounters()) {
+        this->sampled = readCounters(this->startCounters);
+    }
+    this->start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Stops measuring and records the operation.
+ */
+HeapProfileScope::~HeapProfileScope() {
+    threadProfile.depth -= 1;
+    if (!this->outermost) {
+        return;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    uint64_t nanoseconds = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - this->start).count());
+
+    uint64_t deltas[HeapProfiler::counterCount];
+    bool counted = false;
+    if (this->sampled && readCounters(deltas)) {
+        for (int i = 0; i < HeapProfiler::counterCount; i++) {
+            deltas[i] -= this->startCounters[i];
+        }
+        counted = true;
+    }
+    HeapProfiler::instance().record(this->operation, nanoseconds,
+        threadProfile.cuts - this->startCuts, counted ? deltas : nullptr);
+}
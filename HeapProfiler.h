@@ -0,0 +1,276 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief The heap operations measured by the profiler.
+ */
+enum HeapOperation {
+    opInsert,
+    opExtractMin,
+    opDecreaseKey,
+    opDeleteNode,
+    opUnionHeap,
+    opIncreaseKey,
+    opCount
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief A log-bucketed histogram of non-negative values in the style of HdrHistogram.
+ *
+ * Values below 16 get one bucket each; every power of two above is split
+ * into 16 buckets, so a recorded value is known within about 6 percent.
+ * Recording is a single relaxed atomic increment and is safe from any thread.
+ */
+class LatencyHistogram
+{
+public:
+    static const int subBucketBits = 4;   ///< log2 of the buckets per power of two
+    static const int maxExponent = 47;    ///< Values at or above 2^48 share the last bucket
+    static const int bucketCount = (maxExponent - subBucketBits + 2) << subBucketBits;
+
+private:
+    std::atomic<uint64_t> buckets[bucketCount]; ///< Number of values in every bucket
+    std::atomic<uint64_t> count;                ///< Number of recorded values
+    std::atomic<uint64_t> total;                ///< Sum of the recorded values
+    std::atomic<uint64_t> maximum;              ///< Largest recorded value
+
+public:
+    /**
+     * @brief Constructs an empty histogram.
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Returns the bucket of a value.
+     *
+     * @param value The value.
+     * @return int The index of its bucket.
+     */
+    static int bucketOf(uint64_t value);
+
+    /**
+     * @brief Returns the largest value that falls into a bucket.
+     *
+     * @param bucket The index of the bucket.
+     * @return uint64_t The upper bound of the bucket.
+     */
+    static uint64_t upperBound(int bucket);
+
+    /**
+     * @brief Adds a value to the histogram.
+     *
+     * @param value The value to be recorded.
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Removes every recorded value.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the value below which a fraction of the recorded values lie.
+     *
+     * @param fraction The fraction, between 0 and 1.
+     * @return uint64_t The upper bound of the bucket holding the percentile, 0 if empty.
+     */
+    uint64_t percentile(double fraction) const;
+
+    /**
+     * @brief Returns the number of values in a bucket.
+     *
+     * @param bucket The index of the bucket.
+     * @return uint64_t The number of values.
+     */
+    uint64_t getBucket(int bucket) const;
+
+    /**
+     * @brief Returns the number of recorded values.
+     *
+     * @return uint64_t The number of values.
+     */
+    uint64_t getCount() const;
+
+    /**
+     * @brief Returns the mean of the recorded values.
+     *
+     * @return double The mean, 0 if empty.
+     */
+    double getMean() const;
+
+    /**
+     * @brief Returns the largest recorded value.
+     *
+     * @return uint64_t The maximum, 0 if empty.
+     */
+    uint64_t getMax() const;
+};
+
+/**
+ * @class HeapProfiler
+ * @brief Collects latency histograms and hardware counters of Fibonacci Heap operations.
+ *
+ * FibonacciHeap reports to the profiler only when it is compiled with
+ * FIBHEAP_PROFILE defined; otherwise the profiling macros expand to nothing
+ * and this file does not have to be linked. Every operation gets a latency
+ * histogram in nanoseconds and a histogram of the cuts it made, which shows
+ * the length of cascading cut chains. Operations called by other operations,
+ * like the extractMin inside deleteNode, are counted only as the outer one.
+ *
+ * On Linux, setCounterSampling reads the cache miss, branch miss and
+ * instruction counters of the calling thread with perf_event_open around
+ * every n-th operation. Reading them costs a system call, which is why they
+ * are sampled.
+ */
+class HeapProfiler
+{
+public:
+    static const int counterCount = 3;   ///< Cache misses, branch misses and instructions
+
+private:
+    /**
+     * @brief Everything recorded for one operation.
+     */
+    struct OperationStats {
+        LatencyHistogram latency;                       ///< Latency in nanoseconds
+        LatencyHistogram cuts;                          ///< Cuts made by one call
+        std::atomic<uint64_t> samples;                  ///< Calls measured with counters
+        std::atomic<uint64_t> counters[counterCount];   ///< Counter totals over the samples
+    };
+
+    OperationStats stats[opCount];        ///< Statistics by operation
+    std::atomic<int> samplePeriod;        ///< Counters are read every n-th call, 0 when off
+
+    /**
+     * @brief Constructs a profiler with counters disabled.
+     */
+    HeapProfiler();
+
+public:
+    HeapProfiler(const HeapProfiler&) = delete;
+    HeapProfiler& operator=(const HeapProfiler&) = delete;
+
+    /**
+     * @brief Returns the profiler shared by every heap.
+     *
+     * @return HeapProfiler& The profiler.
+     */
+    static HeapProfiler& instance();
+
+    /**
+     * @brief Returns the name of an operation.
+     *
+     * @param operation The operation.
+     * @return const char* Its name, as used in the reports.
+     */
+    static const char* operationName(HeapOperation operation);
+
+    /**
+     * @brief Reads hardware counters around every n-th operation of each thread.
+     *
+     * @param period The sampling period, 0 to stop reading counters.
+     */
+    void setCounterSampling(int period);
+
+    /**
+     * @brief Returns the hardware counter sampling period.
+     *
+     * @return int The period, 0 when counters are not read.
+     */
+    int getCounterSampling() const;
+
+    /**
+     * @brief Records one completed operation.
+     *
+     * @param operation The operation.
+     * @param nanoseconds Its latency.
+     * @param cuts The number of cuts it made.
+     * @param counters The counter deltas, nullptr if the call was not sampled.
+     */
+    void record(HeapOperation operation, uint64_t nanoseconds, uint64_t cuts, const uint64_t* counters);
+
+    /**
+     * @brief Removes everything recorded so far.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the latency histogram of an operation.
+     *
+     * @param operation The operation.
+     * @return const LatencyHistogram& The histogram in nanoseconds.
+     */
+    const LatencyHistogram& getLatency(HeapOperation operation) const;
+
+    /**
+     * @brief Returns the histogram of cuts per call of an operation.
+     *
+     * @param operation The operation.
+     * @return const LatencyHistogram& The histogram.
+     */
+    const LatencyHistogram& getCuts(HeapOperation operation) const;
+
+    /**
+     * @brief Exports every statistic, including the non-empty buckets, as JSON.
+     *
+     * @return std::string The JSON document.
+     */
+    std::string toJson() const;
+
+    /**
+     * @brief Formats the statistics as a text table with one line per operation.
+     *
+     * @return std::string The table.
+     */
+    std::string toTable() const;
+
+    /**
+     * @brief Counts one cut made by the operation running on this thread.
+     */
+    static void countCut();
+
+    friend class HeapProfileScope;
+};
+
+/**
+ * @class HeapProfileScope
+ * @brief Measures the heap operation that runs while the object is alive.
+ */
+class HeapProfileScope
+{
+private:
+    HeapOperation operation;                        ///< The measured operation
+    bool outermost;                                 ///< False inside another measured operation
+    bool sampled;                                   ///< Whether counters are read for this call
+    uint64_t startCuts;                             ///< Cuts of the thread at the start
+    uint64_t startCounters[HeapProfiler::counterCount]; ///< Counter values at the start
+    std::chrono::steady_clock::time_point start;    ///< Time at the start
+
+public:
+    /**
+     * @brief Starts measuring an operation.
+     *
+     * @param op The operation.
+     */
+    explicit HeapProfileScope(HeapOperation op);
+
+    /**
+     * @brief Stops measuring and records the operation.
+     */
+    ~HeapProfileScope();
+
+    HeapProfileScope(const HeapProfileScope&) = delete;
+    HeapProfileScope& operator=(const HeapProfileScope&) = delete;
+};
+
+#ifdef FIBHEAP_PROFILE
+#define FIBHEAP_PROFILE_SCOPE(operation) HeapProfileScope heapProfileScope(operation)
+#define FIBHEAP_PROFILE_CUT() HeapProfiler::countCut()
+#else
+#define FIBHEAP_PROFILE_SCOPE(operation)
+#define FIBHEAP_PROFILE_CUT()
+#endif
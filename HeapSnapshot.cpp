@@ -0,0 +1,381 @@
+#include "HeapSnapshot.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char snapshotMagic[8] = { 'F', 'I', 'B', 'S', 'N', 'A', 'P', '1' };
+static const uint32_t snapshotVersion = 3;
+static const size_t recordsPerWrite = 1 << 16;
+
+/**
+ * @brief Fixed size header at the start of a snapshot.
+ */
+struct SnapshotHeader {
+    char magic[8];        ///< Always "FIBSNAP1"
+    uint32_t version;     ///< Format version
+    uint32_t recordSize;  ///< Size of one SnapshotRecord in bytes
+    uint64_t count;       ///< Number of records
+    int64_t minIndex;     ///< Record index of the minimum node, 0, or -1 if empty
+};
+
+/**
+ * @brief One node of the heap, in depth first order from the minimum node.
+ *
+ * Siblings follow each other in ring order and every node comes after its
+ * parent, so the parent index is enough to rebuild the child and sibling links.
+ */
+struct SnapshotRecord {
+    int64_t key;        ///< The key of the node
+    int64_t parent;     ///< Index of the parent, -1 for roots
+    int32_t id;         ///< The id of the node
+    uint8_t degree;     ///< Number of children
+    uint8_t marked;     ///< 1 if the node is marked, 0 otherwise
+    uint16_t reserved;  ///< Always 0
+};
+
+/**
+ * @brief Incremental 64-bit FNV-1a checksum over 8-byte words.
+ */
+class SnapshotChecksum {
+private:
+    uint64_t hash = 14695981039346656037ULL;
+
+public:
+    void update(const void* data, size_t bytes) {
+        const unsigned char* current = static_cast<const unsigned char*>(data);
+        while (bytes >= sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, current, sizeof(word));
+            hash = (hash ^ word) * 1099511628211ULL;
+            current += sizeof(word);
+            bytes -= sizeof(word);
+        }
+        while (bytes > 0) {
+            hash = (hash ^ *current) * 1099511628211ULL;
+            current += 1;
+            bytes -= 1;
+        }
+    }
+
+    uint64_t value() const {
+        return hash;
+    }
+};
+
+/**
+ * @brief Writes the full structure of a heap to a file.
+ *
+ * @param heap The heap to be saved. It is not modified.
+ * @param path The path of the snapshot file.
+ * @return bool True if the snapshot was written, false otherwise.
+ */
+bool HeapSnapshot::save(const FibonacciHeap* heap, const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "Saving the snapshot failed, because " << path << " cannot be created.\n";
+        return false;
+    }
+
+    SnapshotChecksum checksum;
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.version = snapshotVersion;
+    header.recordSize = sizeof(SnapshotRecord);
+    header.count = uint64_t(heap->getSize());
+    header.minIndex = heap->getMinNode() == nullptr ? -1 : 0;
+    checksum.update(&header, sizeof(header));
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Walk the trees depth first, starting at the minimum node, keeping only
+    // the ring being walked at every level of the current path. A node gets
+    // its index when it is written, so no index of the whole heap is needed.
+    struct Frame {
+        const Node* first;   ///< The node the ring walk started at
+        const Node* current; ///< The next node of the ring to be written
+        int64_t parent;      ///< Index of the parent of the ring, -1 for roots
+    };
+    std::vector<Frame> walk;
+    if (heap->getMinNode() != nullptr) {
+        walk.push_back(Frame{ heap->getMinNode(), heap->getMinNode(), -1 });
+    }
+
+    std::vector<SnapshotRecord> buffer;
+    buffer.reserve(recordsPerWrite);
+    uint64_t written = 0;
+    while (!walk.empty()) {
+        Frame& frame = walk.back();
+        const Node* node = frame.current;
+        int64_t parent = frame.parent;
+        frame.current = node->getRight();
+        if (frame.current == frame.first) {
+            walk.pop_back();
+        }
+        int64_t index = int64_t(written);
+        written += 1;
+        if (node->getChild() != nullptr) {
+            walk.push_back(Frame{ node->getChild(), node->getChild(), index });
+        }
+
+        SnapshotRecord record;
+        record.key = node->getKey();
+        record.parent = parent;
+        record.id = node->getId();
+        record.degree = uint8_t(node->getDegree());
+        record.marked = node->getMark() ? 1 : 0;
+        record.reserved = 0;
+        buffer.push_back(record);
+
+        if (buffer.size() == recordsPerWrite || walk.empty()) {
+            size_t bytes = buffer.size() * sizeof(SnapshotRecord);
+            checksum.update(buffer.data(), bytes);
+            out.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(bytes));
+            buffer.clear();
+        }
+    }
+
+    if (written != header.count) {
+        std::cout << "Saving the snapshot failed, because the heap holds " << written
+            << " nodes but its size is " << header.count << ".\n";
+        return false;
+    }
+
+    uint64_t sum = checksum.value();
+    out.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+    out.flush();
+    if (!out) {
+        std::cout << "Saving the snapshot failed, because " << path << " could not be written.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps a snapshot file and checks its header, size and checksum.
+ *
+ * @param path The path of the snapshot file.
+ * @param bytes Set to the size of the mapping.
+ * @param count Set to the number of records.
+ * @return const char* The mapping, to be unmapped by the caller, or nullptr if
+ * the file is missing, malformed or fails the checksum.
+ */
+static const char* mapSnapshot(const std::string& path, size_t& bytes, size_t& count) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "Loading the snapshot failed, because " << path << " cannot be opened.\n";
+        return nullptr;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(SnapshotHeader) + sizeof(uint64_t)) {
+        ::close(fd);
+        std::cout << "Loading the snapshot failed, because " << path << " is truncated.\n";
+        return nullptr;
+    }
+
+    bytes = size_t(info.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cout << "Loading the snapshot failed, because " << path << " cannot be mapped.\n";
+        return nullptr;
+    }
+    ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+    const char* data = static_cast<const char*>(mapping);
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) == 0
+        && header.version < snapshotVersion) {
+        ::munmap(mapping, bytes);
+        std::cout << "Loading the snapshot failed, because " << path
+            << " was written in an older format version.\n";
+        return nullptr;
+    }
+
+    bool valid = std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) == 0
+        && header.version == snapshotVersion
+        && header.recordSize == sizeof(SnapshotRecord)
+        && header.count <= (bytes - sizeof(header) - sizeof(uint64_t)) / sizeof(SnapshotRecord)
+        && sizeof(header) + header.count * sizeof(SnapshotRecord) + sizeof(uint64_t) == bytes
+        && header.minIndex == (header.count == 0 ? -1 : 0);
+
+    if (valid) {
+        SnapshotChecksum checksum;
+        checksum.update(data, bytes - sizeof(uint64_t));
+        uint64_t stored;
+        std::memcpy(&stored, data + bytes - sizeof(uint64_t), sizeof(stored));
+        valid = stored == checksum.value();
+    }
+    if (!valid) {
+        ::munmap(mapping, bytes);
+        std::cout << "Loading the snapshot failed, because " << path << " is corrupted or incomplete.\n";
+        return nullptr;
+    }
+
+    count = size_t(header.count);
+    return data;
+}
+
+/**
+ * @brief Links nodes into the trees described by the records.
+ *
+ * Node i gets the key, mark and links of record i; its id is left as it is.
+ *
+ * @param records The records, in depth first order from the minimum node.
+ * @param nodes One node for every record, in the same order.
+ * @return bool True if the records describe valid trees, false otherwise.
+ */
+static bool linkRecords(const SnapshotRecord* records, const std::vector<Node*>& nodes) {
+    // Records come in depth first order, so appending every node to the end of
+    // its parent's child ring, or of the root ring, rebuilds the exact rings.
+    size_t count = nodes.size();
+    bool linked = true;
+    for (size_t i = 0; i < count && linked; i++) {
+        const SnapshotRecord& record = records[i];
+        Node* node = nodes[i];
+        node->setKey(record.key);
+        node->setParent(nullptr);
+        node->setChild(nullptr);
+        node->setDegree(0);
+        node->setMark(record.marked != 0);
+        node->setLeft(node);
+        node->setRight(node);
+
+        if (i == 0 || record.parent < 0) {
+            linked = record.parent == -1;
+            if (i == 0 || !linked) {
+                continue;
+            }
+            Node* first = nodes[0];
+            node->setLeft(first->getLeft());
+            node->setRight(first);
+            first->getLeft()->setRight(node);
+            first->setLeft(node);
+            continue;
+        }
+
+        // A parent always comes before its children.
+        linked = record.parent < int64_t(i) && nodes[size_t(record.parent)]->getDegree() < 255;
+        if (!linked) {
+            break;
+        }
+        Node* parent = nodes[size_t(record.parent)];
+        node->setParent(parent);
+        Node* first = parent->getChild();
+        if (first == nullptr) {
+            parent->setChild(node);
+        }
+        else {
+            node->setLeft(first->getLeft());
+            node->setRight(first);
+            first->getLeft()->setRight(node);
+            first->setLeft(node);
+        }
+        parent->setDegree(parent->getDegree() + 1);
+    }
+    for (size_t i = 0; i < count && linked; i++) {
+        linked = nodes[i]->getDegree() == records[i].degree;
+    }
+    return linked;
+}
+
+/**
+ * @brief Restores a heap from a snapshot file.
+ *
+ * @param path The path of the snapshot file.
+ * @return FibonacciHeap* The restored heap, or nullptr if the file is missing,
+ * malformed or fails the checksum.
+ */
+FibonacciHeap* HeapSnapshot::load(const std::string& path) const {
+    size_t bytes = 0;
+    size_t count = 0;
+    const char* data = mapSnapshot(path, bytes, count);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    const SnapshotRecord* records = reinterpret_cast<const SnapshotRecord*>(data + sizeof(SnapshotHeader));
+
+    std::vector<Node*> nodes(count, nullptr);
+    for (size_t i = 0; i < count; i++) {
+        nodes[i] = new Node(records[i].key, records[i].id);
+    }
+    bool linked = linkRecords(records, nodes);
+    ::munmap(const_cast<char*>(data), bytes);
+
+    if (!linked) {
+        for (Node* node : nodes) {
+            delete node;
+        }
+        std::cout << "Loading the snapshot failed, because " << path << " has invalid links.\n";
+        return nullptr;
+    }
+
+    FibonacciHeap* heap = new FibonacciHeap();
+    heap->setMinNode(count == 0 ? nullptr : nodes[0]);
+    heap->numNodes = (long long)count;
+    return heap;
+}
+
+/**
+ * @brief Writes the full structure of an indexed heap to a file.
+ *
+ * @param heap The heap to be saved. It is not modified.
+ * @param path The path of the snapshot file.
+ * @return bool True if the snapshot was written, false otherwise.
+ */
+bool HeapSnapshot::save(const IndexedFibonacciHeap* heap, const std::string& path) const {
+    return this->save(&heap->heap, path);
+}
+
+/**
+ * @brief Restores an indexed heap from a snapshot file.
+ *
+ * @param path The path of the snapshot file.
+ * @return IndexedFibonacciHeap* The restored heap, or nullptr if the file is
+ * missing, malformed, fails the checksum or has a negative or repeated id.
+ */
+IndexedFibonacciHeap* HeapSnapshot::loadIndexed(const std::string& path) const {
+    size_t bytes = 0;
+    size_t count = 0;
+    const char* data = mapSnapshot(path, bytes, count);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    const SnapshotRecord* records = reinterpret_cast<const SnapshotRecord*>(data + sizeof(SnapshotHeader));
+
+    // Every record takes the node of its id from the blocks of the indexed
+    // heap, so the nodes come in blocks of nodesPerBlock, not one by one.
+    IndexedFibonacciHeap* indexed = new IndexedFibonacciHeap();
+    std::vector<Node*> nodes(count, nullptr);
+    bool unique = true;
+    for (size_t i = 0; i < count && unique; i++) {
+        int id = records[i].id;
+        unique = id >= 0 && !indexed->contains(id);
+        if (unique) {
+            indexed->reserveId(id);
+            indexed->present[id] = true;
+            nodes[i] = indexed->nodeAt(id);
+        }
+    }
+    bool linked = unique && linkRecords(records, nodes);
+    ::munmap(const_cast<char*>(data), bytes);
+
+    if (!linked) {
+        delete indexed;
+        std::cout << "Loading the snapshot failed, because " << path
+            << (unique ? " has invalid links.\n" : " has a negative or repeated id.\n");
+        return nullptr;
+    }
+
+    indexed->heap.setMinNode(count == 0 ? nullptr : nodes[0]);
+    indexed->heap.numNodes = (long long)count;
+    return indexed;
+}
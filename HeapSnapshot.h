@@ -0,0 +1,76 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include "IndexedFibonacciHeap.h"
+#include <string>
+
+/**
+ * @class HeapSnapshot
+ * @brief Saves a Fibonacci Heap to a file and restores it with the same shape.
+ *
+ * A snapshot stores every node as a fixed size record holding its key, id,
+ * degree, mark and the record index of its parent, in depth first order from
+ * the minimum node, so the file does not depend on where the nodes lived in
+ * memory. A restore maps the file and rebuilds the exact trees, sibling order
+ * and minimum node without inserting or consolidating anything. A checksum at
+ * the end of the file detects snapshots that were only partially written.
+ * Records use the native byte order.
+ *
+ * load returns a plain FibonacciHeap and has to allocate every node on its
+ * own, since the caller deletes the nodes extractMin returns one by one. This
+ * is a limitation: restoring n nodes costs n allocations. Heaps whose ids are
+ * unique and not negative can be restored with loadIndexed instead, which puts
+ * the nodes in the blocks of an IndexedFibonacciHeap.
+ */
+class HeapSnapshot {
+public:
+    /**
+     * @brief Writes the full structure of a heap to a file.
+     *
+     * The records are streamed through a fixed size buffer while the trees are
+     * walked. Besides the buffer, saving only keeps one entry per level of the
+     * deepest path, never a copy or an index of the whole heap.
+     *
+     * @param heap The heap to be saved. It is not modified.
+     * @param path The path of the snapshot file.
+     * @return bool True if the snapshot was written, false otherwise.
+     */
+    bool save(const FibonacciHeap* heap, const std::string& path) const;
+
+    /**
+     * @brief Restores a heap from a snapshot file.
+     *
+     * Every node is allocated with its own new, as insert would, so restoring
+     * n nodes costs n allocations, but no key comparisons.
+     *
+     * @param path The path of the snapshot file.
+     * @return FibonacciHeap* The restored heap, or nullptr if the file is missing,
+     * malformed or fails the checksum.
+     */
+    FibonacciHeap* load(const std::string& path) const;
+
+    /**
+     * @brief Writes the full structure of an indexed heap to a file.
+     *
+     * The file has the same format as the snapshot of a plain heap, with the
+     * id of every element in its record.
+     *
+     * @param heap The heap to be saved. It is not modified.
+     * @param path The path of the snapshot file.
+     * @return bool True if the snapshot was written, false otherwise.
+     */
+    bool save(const IndexedFibonacciHeap* heap, const std::string& path) const;
+
+    /**
+     * @brief Restores an indexed heap from a snapshot file.
+     *
+     * The node of every record is the node of its id in the blocks of the
+     * indexed heap, so restoring allocates one block per nodesPerBlock ids
+     * instead of one node per record. Any snapshot whose ids are unique and
+     * not negative can be restored this way, including one of a plain heap.
+     *
+     * @param path The path of the snapshot file.
+     * @return IndexedFibonacciHeap* The restored heap, or nullptr if the file is
+     * missing, malformed, fails the checksum or has a negative or repeated id.
+     */
+    IndexedFibonacciHeap* loadIndexed(const std::string& path) const;
+};
@@ -0,0 +1,117 @@
+#include "HeapValidator.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Checks every invariant of a heap.
+ *
+ * @param heap The heap to be checked. It is not modified.
+ * @param error Set to a description of the first violation found.
+ * @return bool True if the heap is valid, false otherwise.
+ */
+bool HeapValidator::validate(const FibonacciHeap* heap, std::string& error) const {
+    std::ostringstream message;
+    const Node* minNode = heap->minNode;
+    long long expected = heap->numNodes;
+
+    if ((minNode == nullptr) != (expected == 0)) {
+        message << "minNode is " << (minNode == nullptr ? "null" : "set") << " but numNodes is " << expected;
+        error = message.str();
+        return false;
+    }
+    if (minNode == nullptr) {
+        return true;
+    }
+    if (minNode->getParent() != nullptr) {
+        error = "minNode is not a root";
+        return false;
+    }
+
+    // Every ring is walked once, from the root ring down. A ring is given by
+    // one of its nodes and the parent that all its nodes must point to. Walks
+    // are bounded by numNodes so that a broken ring cannot loop forever.
+    std::vector<std::pair<const Node*, const Node*>> rings;
+    rings.push_back(std::make_pair(minNode, nullptr));
+    long long counted = 0;
+
+    while (!rings.empty()) {
+        const Node* start = rings.back().first;
+        const Node* parent = rings.back().second;
+        rings.pop_back();
+
+        const Node* node = start;
+        do {
+            counted += 1;
+            if (counted > expected) {
+                message << "more nodes are reachable than numNodes = " << expected;
+                error = message.str();
+                return false;
+            }
+            if (node->getRight()->getLeft() != node || node->getLeft()->getRight() != node) {
+                message << "the sibling ring is broken at the node with key " << node->getKey();
+                error = message.str();
+                return false;
+            }
+            if (node->getParent() != parent) {
+                message << "the node with key " << node->getKey() << " has a wrong parent pointer";
+                error = message.str();
+                return false;
+            }
+            if (parent != nullptr && node->getKey() < parent->getKey()) {
+                message << "heap order is violated: key " << node->getKey()
+                    << " is below its parent's key " << parent->getKey();
+                error = message.str();
+                return false;
+            }
+            if (parent == nullptr && node->getKey() < minNode->getKey()) {
+                message << "minNode holds key " << minNode->getKey()
+                    << " but a root holds the smaller key " << node->getKey();
+                error = message.str();
+                return false;
+            }
+
+            // The degree must match the length of the child ring.
+            const Node* child = node->getChild();
+            long long children = 0;
+            if (child != nullptr) {
+                const Node* current = child;
+                do {
+                    children += 1;
+                    current = current->getRight();
+                } while (current != child && children <= expected);
+                rings.push_back(std::make_pair(child, node));
+            }
+            if (children != node->getDegree()) {
+                message << "the node with key " << node->getKey() << " has degree " << node->getDegree()
+                    << " but " << children << " children";
+                error = message.str();
+                return false;
+            }
+            node = node->getRight();
+        } while (node != start);
+    }
+
+    if (counted != expected) {
+        message << "numNodes is " << expected << " but " << counted << " nodes are reachable";
+        error = message.str();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks a heap and aborts with a message on std::cerr if it is invalid.
+ *
+ * @param heap The heap to be checked.
+ * @param operation The operation that just ran, for the message.
+ */
+void HeapValidator::check(const FibonacciHeap* heap, const char* operation) const {
+    std::string error;
+    if (!this->validate(heap, error)) {
+        std::cerr << "Fibonacci Heap invariant violated after " << operation << ": " << error << std::endl;
+        std::abort();
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <string>
+
+/**
+ * @class HeapValidator
+ * @brief Checks the structural invariants of a Fibonacci Heap.
+ *
+ * The validator walks every tree and checks that the sibling rings are
+ * consistent, that every node points to its parent, that keys are heap
+ * ordered, that every degree matches the length of the child ring, that
+ * numNodes matches the number of nodes and that minNode is a root holding
+ * the minimum key. When FIBHEAP_VALIDATE is defined, FibonacciHeap runs the
+ * check after every public operation and aborts on the first violation;
+ * otherwise FIBHEAP_CHECK expands to nothing and the validator costs nothing.
+ */
+class HeapValidator {
+public:
+    /**
+     * @brief Checks every invariant of a heap.
+     *
+     * @param heap The heap to be checked. It is not modified.
+     * @param error Set to a description of the first violation found.
+     * @return bool True if the heap is valid, false otherwise.
+     */
+    bool validate(const FibonacciHeap* heap, std::string& error) const;
+
+    /**
+     * @brief Checks a heap and aborts with a message on std::cerr if it is invalid.
+     *
+     * @param heap The heap to be checked.
+     * @param operation The operation that just ran, for the message.
+     */
+    void check(const FibonacciHeap* heap, const char* operation) const;
+};
+
+#ifdef FIBHEAP_VALIDATE
+#define FIBHEAP_CHECK(heap, operation) HeapValidator().check(heap, operation)
+#else
+#define FIBHEAP_CHECK(heap, operation)
+#endif
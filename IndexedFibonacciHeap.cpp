@@ -0,0 +1,168 @@
+#include "IndexedFibonacciHeap.h"
+#include <iostream>
+
+/**
+ * @brief Constructs an empty indexed heap.
+ *
+ * @param capacity The number of ids to reserve room for. Larger ids add blocks.
+ */
+IndexedFibonacciHeap::IndexedFibonacciHeap(int capacity) {
+    if (capacity > 0) {
+        this->reserveId(capacity - 1);
+    }
+}
+
+/**
+ * @brief Destroys the heap and the nodes of all ids.
+ */
+IndexedFibonacciHeap::~IndexedFibonacciHeap() {
+    // The nodes belong to the blocks, so the heap must not delete them.
+    this->heap.minNode = nullptr;
+    this->heap.numNodes = 0;
+}
+
+/**
+ * @brief Returns the node of an id.
+ *
+ * @param id An id below the number of allocated nodes.
+ * @return Node* The node of the id.
+ */
+Node* IndexedFibonacciHeap::nodeAt(int id) {
+    return &this->blocks[size_t(id / nodesPerBlock)][size_t(id % nodesPerBlock)];
+}
+
+/**
+ * @brief Allocates blocks until an id has a node.
+ *
+ * @param id The id that needs a node.
+ */
+void IndexedFibonacciHeap::reserveId(int id) {
+    while (this->present.size() <= size_t(id)) {
+        // Each block is filled to its reserved size at once, so it is never
+        // reallocated and the heap can keep pointers to its nodes.
+        int first = int(this->present.size());
+        this->blocks.emplace_back();
+        std::vector<Node>& block = this->blocks.back();
+        block.reserve(nodesPerBlock);
+        for (int i = 0; i < nodesPerBlock; i++) {
+            block.emplace_back(0, first + i);
+        }
+        this->present.resize(this->present.size() + nodesPerBlock, false);
+    }
+}
+
+/**
+ * @brief Inserts an id or changes its key.
+ *
+ * @param id The id of the element.
+ * @param key The new key of the element.
+ */
+void IndexedFibonacciHeap::upsert(int id, long long key) {
+    if (id < 0) {
+        std::cout << "Upserting failed, because the id is negative.\n";
+        return;
+    }
+    this->reserveId(id);
+
+    Node* node = this->nodeAt(id);
+    if (!this->present[id]) {
+        node->setKey(key);
+        this->heap.insertNode(node);
+        this->present[id] = true;
+    }
+    else if (key < node->getKey()) {
+        this->heap.decreaseKey(node, key);
+    }
+    else if (key > node->getKey()) {
+        this->heap.increaseKey(node, key);
+    }
+}
+
+/**
+ * @brief Checks if an id is in the heap.
+ *
+ * @param id The id to look for.
+ * @return True if the id is in the heap, false otherwise.
+ */
+bool IndexedFibonacciHeap::contains(int id) const {
+    return id >= 0 && size_t(id) < this->present.size() && this->present[id];
+}
+
+/**
+ * @brief Removes an id from the heap. Absent ids are ignored.
+ *
+ * @param id The id to be removed.
+ */
+void IndexedFibonacciHeap::erase(int id) {
+    if (!this->contains(id)) {
+        return;
+    }
+    this->heap.removeNode(this->nodeAt(id));
+    this->present[id] = false;
+}
+
+/**
+ * @brief Returns the key of an id.
+ *
+ * @param id The id.
+ * @param key Set to the key of the id if it is in the heap.
+ * @return bool True if the id is in the heap, false otherwise.
+ */
+bool IndexedFibonacciHeap::keyOf(int id, long long& key) const {
+    if (!this->contains(id)) {
+        return false;
+    }
+    key = this->blocks[size_t(id / nodesPerBlock)][size_t(id % nodesPerBlock)].getKey();
+    return true;
+}
+
+/**
+ * @brief Removes the element with the minimum key.
+ *
+ * @return int The id of the removed element, -1 if the heap was empty.
+ */
+int IndexedFibonacciHeap::extractMin() {
+    Node* minNode = this->heap.extractMin();
+    if (minNode == nullptr) {
+        return -1;
+    }
+    int id = minNode->getId();
+    this->present[id] = false;
+    return id;
+}
+
+/**
+ * @brief Returns the id of the element with the minimum key.
+ *
+ * @return int The id of the minimum element, -1 if the heap is empty.
+ */
+int IndexedFibonacciHeap::getMinId() const {
+    return this->heap.isEmpty() ? -1 : this->heap.getMinNode()->getId();
+}
+
+/**
+ * @brief Returns the minimum key in the heap.
+ *
+ * @return long long The minimum key in the heap.
+ */
+long long IndexedFibonacciHeap::getMinValue() const {
+    return this->heap.getMinValue();
+}
+
+/**
+ * @brief Checks if the heap is empty.
+ *
+ * @return True if the heap is empty, false otherwise.
+ */
+bool IndexedFibonacciHeap::isEmpty() const {
+    return this->heap.isEmpty();
+}
+
+/**
+ * @brief Returns the number of ids in the heap.
+ *
+ * @return long long The number of ids in the heap.
+ */
+long long IndexedFibonacciHeap::getSize() const {
+    return this->heap.getSize();
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <vector>
+
+/**
+ * @class IndexedFibonacciHeap
+ * @brief A Fibonacci Heap addressed by dense integer ids.
+ *
+ * Callers that identify their elements by small integers, such as vertices or
+ * job slots, can update them by id without keeping their own map from ids to
+ * nodes. The node of every id lives in blocks of nodesPerBlock nodes owned by
+ * this class, at a position computed from the id, so a lookup is a single array
+ * access and no node is allocated or freed on its own. Blocks never move, so
+ * the heap can link the nodes directly.
+ */
+class IndexedFibonacciHeap
+{
+    friend class HeapSnapshot;
+
+private:
+    static const int nodesPerBlock = 4096; ///< Number of nodes allocated together
+
+    FibonacciHeap heap;                  ///< The heap linking the nodes of the present ids
+    std::vector<std::vector<Node>> blocks; ///< Node storage, never reallocated once filled
+    std::vector<bool> present;           ///< Whether each id is in the heap
+
+    /**
+     * @brief Returns the node of an id.
+     *
+     * @param id An id below the number of allocated nodes.
+     * @return Node* The node of the id.
+     */
+    Node* nodeAt(int id);
+
+    /**
+     * @brief Allocates blocks until an id has a node.
+     *
+     * @param id The id that needs a node.
+     */
+    void reserveId(int id);
+
+public:
+    /**
+     * @brief Constructs an empty indexed heap.
+     *
+     * @param capacity The number of ids to reserve room for. Larger ids add blocks.
+     */
+    IndexedFibonacciHeap(int capacity = 0);
+
+    /**
+     * @brief Destroys the heap and the nodes of all ids.
+     */
+    ~IndexedFibonacciHeap();
+
+    IndexedFibonacciHeap(const IndexedFibonacciHeap&) = delete;
+    IndexedFibonacciHeap& operator=(const IndexedFibonacciHeap&) = delete;
+
+    /**
+     * @brief Inserts an id or changes its key.
+     *
+     * An absent id is inserted. A smaller key is applied with decreaseKey and a
+     * larger one with increaseKey, both on the node the id already has.
+     *
+     * @param id The id of the element.
+     * @param key The new key of the element.
+     */
+    void upsert(int id, long long key);
+
+    /**
+     * @brief Checks if an id is in the heap.
+     *
+     * @param id The id to look for.
+     * @return True if the id is in the heap, false otherwise.
+     */
+    bool contains(int id) const;
+
+    /**
+     * @brief Removes an id from the heap. Absent ids are ignored.
+     *
+     * @param id The id to be removed.
+     */
+    void erase(int id);
+
+    /**
+     * @brief Returns the key of an id.
+     *
+     * Any key, 0 included, is valid, so absence is reported by the return
+     * value instead of a special key.
+     *
+     * @param id The id.
+     * @param key Set to the key of the id if it is in the heap.
+     * @return bool True if the id is in the heap, false otherwise.
+     */
+    bool keyOf(int id, long long& key) const;
+
+    /**
+     * @brief Removes the element with the minimum key.
+     *
+     * @return int The id of the removed element, -1 if the heap was empty.
+     */
+    int extractMin();
+
+    /**
+     * @brief Returns the id of the element with the minimum key.
+     *
+     * @return int The id of the minimum element, -1 if the heap is empty.
+     */
+    int getMinId() const;
+
+    /**
+     * @brief Returns the minimum key in the heap.
+     *
+     * @return long long The minimum key in the heap.
+     */
+    long long getMinValue() const;
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return True if the heap is empty, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the number of ids in the heap.
+     *
+     * @return long long The number of ids in the heap.
+     */
+    long long getSize() const;
+};
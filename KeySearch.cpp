@@ -0,0 +1,156 @@
+#include "KeySearch.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KEYSEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Returns the position of the first key equal to a value.
+ *
+ * @param keys The keys.
+ * @param count The number of keys.
+ * @param value A value that occurs in keys.
+ * @return int The index of the first occurrence.
+ */
+static int firstIndexOf(const long long* keys, int count, long long value) {
+    for (int i = 0; i < count; i++) {
+        if (keys[i] == value) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#ifdef KEYSEARCH_X86
+/**
+ * @brief AVX2 version of minIndex: four lanes, min built from compare and blend.
+ */
+__attribute__((target("avx2")))
+static int minIndexAvx2(const long long* keys, int count) {
+    if (count < 8) {
+        return KeySearch::minIndexScalar(keys, count);
+    }
+
+    __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys));
+    int i = 4;
+    for (; i + 4 <= count; i += 4) {
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        best = _mm256_blendv_epi8(best, next, _mm256_cmpgt_epi64(best, next));
+    }
+
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), best);
+    long long minimum = lanes[0];
+    for (int lane = 1; lane < 4; lane++) {
+        minimum = lanes[lane] < minimum ? lanes[lane] : minimum;
+    }
+    for (; i < count; i++) {
+        minimum = keys[i] < minimum ? keys[i] : minimum;
+    }
+    return firstIndexOf(keys, count, minimum);
+}
+
+/**
+ * @brief SSE4.2 version of minIndex: two lanes, min built from compare and blend.
+ */
+__attribute__((target("sse4.2")))
+static int minIndexSse42(const long long* keys, int count) {
+    if (count < 4) {
+        return KeySearch::minIndexScalar(keys, count);
+    }
+
+    __m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+    int i = 2;
+    for (; i + 2 <= count; i += 2) {
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        best = _mm_blendv_epi8(best, next, _mm_cmpgt_epi64(best, next));
+    }
+
+    long long lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), best);
+    long long minimum = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+    for (; i < count; i++) {
+        minimum = keys[i] < minimum ? keys[i] : minimum;
+    }
+    return firstIndexOf(keys, count, minimum);
+}
+#endif
+
+typedef int (*MinIndexFunction)(const long long*, int);
+
+/**
+ * @brief An implementation of minIndex and its name.
+ */
+struct Implementation {
+    MinIndexFunction function;   ///< The search
+    const char* name;            ///< "avx2", "sse4.2" or "scalar"
+};
+
+/**
+ * @brief Picks the widest implementation supported by the processor.
+ *
+ * @return Implementation The implementation.
+ */
+static Implementation selectImplementation() {
+#ifdef KEYSEARCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Implementation{ minIndexAvx2, "avx2" };
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Implementation{ minIndexSse42, "sse4.2" };
+    }
+#endif
+    return Implementation{ KeySearch::minIndexScalar, "scalar" };
+}
+
+/**
+ * @brief Returns the implementation, choosing it on the first call.
+ *
+ * A function-local static is initialized on first use and thread-safely, so
+ * callers from the constructors of other static objects get it too.
+ *
+ * @return const Implementation& The implementation.
+ */
+static const Implementation& implementation() {
+    static const Implementation chosen = selectImplementation();
+    return chosen;
+}
+
+/**
+ * @brief Returns the position of the smallest key, the first one on ties.
+ *
+ * @param keys The keys.
+ * @param count The number of keys.
+ * @return int The index of the smallest key, -1 if count is 0.
+ */
+int KeySearch::minIndex(const long long* keys, int count) {
+    return implementation().function(keys, count);
+}
+
+/**
+ * @brief Returns the position of the smallest key with a plain loop.
+ *
+ * @param keys The keys.
+ * @param count The number of keys.
+ * @return int The index of the smallest key, -1 if count is 0.
+ */
+int KeySearch::minIndexScalar(const long long* keys, int count) {
+    int best = count > 0 ? 0 : -1;
+    for (int i = 1; i < count; i++) {
+        if (keys[i] < keys[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Returns the name of the implementation used by minIndex.
+ *
+ * @return const char* "avx2", "sse4.2" or "scalar".
+ */
+const char* KeySearch::getInstructionSet() {
+    return implementation().name;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @class KeySearch
+ * @brief Vectorized search for the smallest key in a packed key array.
+ *
+ * minIndex picks the widest implementation the processor supports when it is
+ * first called: AVX2 compares four 64-bit keys per instruction, SSE4.2 two,
+ * and a scalar loop is used on other processors and compilers. All of them
+ * return the same index.
+ */
+class KeySearch {
+public:
+    /**
+     * @brief Returns the position of the smallest key, the first one on ties.
+     *
+     * @param keys The keys.
+     * @param count The number of keys.
+     * @return int The index of the smallest key, -1 if count is 0.
+     */
+    static int minIndex(const long long* keys, int count);
+
+    /**
+     * @brief Returns the position of the smallest key with a plain loop.
+     *
+     * @param keys The keys.
+     * @param count The number of keys.
+     * @return int The index of the smallest key, -1 if count is 0.
+     */
+    static int minIndexScalar(const long long* keys, int count);
+
+    /**
+     * @brief Returns the name of the implementation used by minIndex.
+     *
+     * @return const char* "avx2", "sse4.2" or "scalar".
+     */
+    static const char* getInstructionSet();
+};
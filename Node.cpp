@@ -4,145 +4,11 @@
  * @brief Constructs a new Node with the given value.
  *
  * @param value The key/value of the node.
+ * @param nodeId Optional identifier carried with the key (-1 if unused).
  */
-Node::Node(int value)
+Node::Node(long long value, int nodeId)
     : key(value), parent(nullptr), child(nullptr),
-    left(this), right(this), degree(0), marked(false) {}
-
-/**
- * @brief Returns the key/value of the node.
- *
- * @return int The key of the node.
- */
-int Node::getKey() const {
-    return key;
-}
-
-/**
- * @brief Sets the key/value of the node.
- *
- * @param newKey The new key of the node.
- */
-void Node::setKey(int newKey)
-{
-    this->key = newKey;
-}
-
-/**
- * @brief Sets the parent of the node.
- *
- * @param sParent Pointer to the parent node.
- */
-void Node::setParent(Node* sParent) {
-    this->parent = sParent;
-}
-
-/**
- * @brief Returns the parent of the node.
- *
- * @return Node* The parent node.
- */
-Node* Node::getParent() const {
-    return parent;
-}
-
-/**
- * @brief Returns the child of the node.
- *
- * @return Node* The child node.
- */
-Node* Node::getChild() const {
-    return child;
-}
-
-/**
- * @brief Sets the child of the node.
- *
- * @param sChild Pointer to the child node.
- */
-void Node::setChild(Node* sChild) {
-    this->child = sChild;
-}
-
-/**
- * @brief Sets the left sibling of the node.
- *
- * @param sLeft Pointer to the left sibling node.
- */
-void Node::setLeft(Node* sLeft) {
-    this->left = sLeft;
-}
-
-/**
- * @brief Returns the left sibling of the node.
- *
- * @return Node* The left sibling node.
- */
-Node* Node::getLeft() const {
-    return left;
-}
-
-/**
- * @brief Sets the right sibling of the node.
- *
- * @param sRight Pointer to the right sibling node.
- */
-void Node::setRight(Node* sRight) {
-    this->right = sRight;
-}
-
-/**
- * @brief Returns the right sibling of the node.
- *
- * @return Node* The right sibling node.
- */
-Node* Node::getRight() const {
-    return right;
-}
-
-/**
- * @brief Increments the degree of the node.
- */
-void Node::incrementDegree()
-{
-    this->degree += 1;
-}
-
-/**
- * @brief Decreases the degree of the node and marks it if it loses a child.
- */
-void Node::decreaseDegree()
-{
-    this->degree -= 1;
-    this->marked = true;
-}
-
-/**
- * @brief Returns the mark status of the node.
- *
- * @return bool True if the node is marked, false otherwise.
- */
-bool Node::getMark() const {
-    return this->marked;
-}
-
-/**
- * @brief Sets the mark status of the node.
- *
- * @param mark The mark status to be set.
- */
-void Node::setMark(bool mark) {
-    this->marked = mark;
-}
-
-/**
- * @brief Returns the degree of the node.
- *
- * @return int The degree of the node (number of children).
- */
-int Node::getDegree() const {
-    return this->degree;
-}
+    left(this), right(this), id(nodeId), degree(0), marked(false) {}
 
 /**
  * @brief Adds a sibling to the right of this node.
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 
 /**
  * @class Node
@@ -10,12 +11,13 @@
 class Node
 {
 private:
-    int key;               ///< The key/value of the node
+    long long key;         ///< The key/value of the node
     Node* parent;          ///< Pointer to the parent node
     Node* child;           ///< Pointer to one of the children
     Node* left;            ///< Pointer to the left sibling
     Node* right;           ///< Pointer to the right sibling
-    int degree;            ///< Number of children
+    int id;                ///< Caller supplied identifier carried with the key
+    uint8_t degree;        ///< Number of children, at most about 1.44 * log2(size) < 93
     bool marked;           ///< Indicates if the node is marked (lost a child)
 
 public:
@@ -23,22 +25,37 @@ public:
      * @brief Constructs a new Node with the given value.
      *
      * @param value The key/value of the node.
+     * @param nodeId Optional identifier carried with the key (-1 if unused).
      */
-    Node(int value);
+    Node(long long value, int nodeId = -1);
 
     /**
      * @brief Returns the key/value of the node.
      *
-     * @return int The key of the node.
+     * @return long long The key of the node.
      */
-    int getKey() const;
+    long long getKey() const;
 
     /**
      * @brief Sets the key/value of the node.
      *
      * @param newKey The new key of the node.
      */
-    void setKey(int newKey);
+    void setKey(long long newKey);
+
+    /**
+     * @brief Returns the identifier carried with the key.
+     *
+     * @return int The identifier of the node, -1 if none was given.
+     */
+    int getId() const;
+
+    /**
+     * @brief Sets the identifier carried with the key.
+     *
+     * @param newId The new identifier of the node.
+     */
+    void setId(int newId);
 
     /**
      * @brief Returns the parent of the node.
@@ -103,6 +120,13 @@ public:
      */
     int getDegree() const;
 
+    /**
+     * @brief Sets the degree of the node.
+     *
+     * @param newDegree The new degree of the node (number of children).
+     */
+    void setDegree(int newDegree);
+
     /**
      * @brief Increments the degree of the node.
      */
@@ -155,3 +179,174 @@ public:
      */
     void link(Node* childNode);
 };
+
+// The 64-bit key takes the place of the 32-bit key and degree, so a node stays
+// at six words on 64-bit targets.
+static_assert(sizeof(void*) != 8 || sizeof(Node) == 48, "Node must stay 48 bytes");
+
+// The accessors are defined here so that the heap loops, which call them for
+// every node they touch, inline them instead of paying a call each.
+
+/**
+ * @brief Returns the key/value of the node.
+ *
+ * @return long long The key of the node.
+ */
+inline long long Node::getKey() const {
+    return key;
+}
+
+/**
+ * @brief Sets the key/value of the node.
+ *
+ * @param newKey The new key of the node.
+ */
+inline void Node::setKey(long long newKey)
+{
+    this->key = newKey;
+}
+
+/**
+ * @brief Returns the identifier carried with the key.
+ *
+ * @return int The identifier of the node, -1 if none was given.
+ */
+inline int Node::getId() const {
+    return id;
+}
+
+/**
+ * @brief Sets the identifier carried with the key.
+ *
+ * @param newId The new identifier of the node.
+ */
+inline void Node::setId(int newId)
+{
+    this->id = newId;
+}
+
+/**
+ * @brief Sets the parent of the node.
+ *
+ * @param sParent Pointer to the parent node.
+ */
+inline void Node::setParent(Node* sParent) {
+    this->parent = sParent;
+}
+
+/**
+ * @brief Returns the parent of the node.
+ *
+ * @return Node* The parent node.
+ */
+inline Node* Node::getParent() const {
+    return parent;
+}
+
+/**
+ * @brief Returns the child of the node.
+ *
+ * @return Node* The child node.
+ */
+inline Node* Node::getChild() const {
+    return child;
+}
+
+/**
+ * @brief Sets the child of the node.
+ *
+ * @param sChild Pointer to the child node.
+ */
+inline void Node::setChild(Node* sChild) {
+    this->child = sChild;
+}
+
+/**
+ * @brief Sets the left sibling of the node.
+ *
+ * @param sLeft Pointer to the left sibling node.
+ */
+inline void Node::setLeft(Node* sLeft) {
+    this->left = sLeft;
+}
+
+/**
+ * @brief Returns the left sibling of the node.
+ *
+ * @return Node* The left sibling node.
+ */
+inline Node* Node::getLeft() const {
+    return left;
+}
+
+/**
+ * @brief Sets the right sibling of the node.
+ *
+ * @param sRight Pointer to the right sibling node.
+ */
+inline void Node::setRight(Node* sRight) {
+    this->right = sRight;
+}
+
+/**
+ * @brief Returns the right sibling of the node.
+ *
+ * @return Node* The right sibling node.
+ */
+inline Node* Node::getRight() const {
+    return right;
+}
+
+/**
+ * @brief Sets the degree of the node.
+ *
+ * @param newDegree The new degree of the node (number of children).
+ */
+inline void Node::setDegree(int newDegree)
+{
+    this->degree = uint8_t(newDegree);
+}
+
+/**
+ * @brief Increments the degree of the node.
+ */
+inline void Node::incrementDegree()
+{
+    this->degree += 1;
+}
+
+/**
+ * @brief Decreases the degree of the node and marks it if it loses a child.
+ */
+inline void Node::decreaseDegree()
+{
+    this->degree -= 1;
+    this->marked = true;
+}
+
+/**
+ * @brief Returns the mark status of the node.
+ *
+ * @return bool True if the node is marked, false otherwise.
+ */
+inline bool Node::getMark() const {
+    return this->marked;
+}
+
+/**
+ * @brief Sets the mark status of the node.
+ *
+ * @param mark The mark status to be set.
+ */
+inline void Node::setMark(bool mark) {
+    this->marked = mark;
+}
+
+/**
+ * @brief Returns the degree of the node.
+ *
+ * @return int The degree of the node (number of children).
+ */
+inline int Node::getDegree() const {
+    return this->degree;
+}
@@ -0,0 +1,87 @@
+#include "Selection.h"
+#include "SoftHeap.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/**
+ * @brief Returns the k-th smallest value in linear time.
+ *
+ * @param values The values. The vector is taken by value and reordered.
+ * @param k The zero based rank of the wanted value.
+ * @return long long The k-th smallest value, 0 if k is out of range.
+ */
+long long Selection::select(std::vector<long long> values, long long k) const {
+    if (k < 0 || k >= (long long)values.size()) {
+        std::cout << "Selecting the value failed, because the rank is out of range.\n";
+        return 0;
+    }
+
+    const size_t smallRange = 32;
+    while (values.size() > smallRange) {
+        size_t n = values.size();
+        SoftHeap heap(1.0 / 3.0);
+        for (long long value : values) {
+            heap.insert(value);
+        }
+
+        long long pivot = 0;
+        for (size_t i = 0; i < n / 3; i++) {
+            long long key;
+            int id;
+            heap.extractMin(key, id);
+            pivot = i == 0 ? key : std::max(pivot, key);
+        }
+
+        // Split into values below, equal to and above the pivot.
+        auto lessEnd = std::partition(values.begin(), values.end(), [pivot](long long v) { return v < pivot; });
+        auto equalEnd = std::partition(lessEnd, values.end(), [pivot](long long v) { return v == pivot; });
+        long long lessCount = lessEnd - values.begin();
+        long long equalCount = equalEnd - lessEnd;
+
+        if (k < lessCount) {
+            values.erase(lessEnd, values.end());
+        }
+        else if (k < lessCount + equalCount) {
+            return pivot;
+        }
+        else {
+            values.erase(values.begin(), equalEnd);
+            k -= lessCount + equalCount;
+        }
+    }
+
+    std::sort(values.begin(), values.end());
+    return values[size_t(k)];
+}
+
+/**
+ * @brief Returns a value whose rank is close to a quantile.
+ *
+ * @param values The values.
+ * @param q The quantile, between 0 and 1.
+ * @param errorRate The error rate of the soft heap, between 0 and 1.
+ * @return long long The value, 0 if values is empty.
+ */
+long long Selection::approximateQuantile(const std::vector<long long>& values, double q, double errorRate) const {
+    if (values.empty()) {
+        std::cout << "Estimating the quantile failed, because there are no values.\n";
+        return 0;
+    }
+
+    SoftHeap heap(errorRate);
+    for (long long value : values) {
+        heap.insert(value);
+    }
+
+    long long count = (long long)std::ceil(std::min(std::max(q, 0.0), 1.0) * double(values.size()));
+    count = std::max(count, 1LL);
+    long long result = 0;
+    for (long long i = 0; i < count; i++) {
+        long long key;
+        int id;
+        heap.extractMin(key, id);
+        result = i == 0 ? key : std::max(result, key);
+    }
+    return result;
+}
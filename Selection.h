@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+
+/**
+ * @class Selection
+ * @brief Exact and approximate order statistics built on the soft heap.
+ */
+class Selection {
+public:
+    /**
+     * @brief Returns the k-th smallest value in linear time.
+     *
+     * Every round inserts the remaining values into a soft heap with error rate
+     * 1/3 and extracts a third of them; the largest extracted value has a rank
+     * between n/3 and 2n/3, so partitioning around it discards at least a third
+     * of the values. The rounds shrink geometrically, which makes the total
+     * time linear in the worst case.
+     *
+     * @param values The values. The vector is taken by value and reordered.
+     * @param k The zero based rank of the wanted value.
+     * @return long long The k-th smallest value, 0 if k is out of range.
+     */
+    long long select(std::vector<long long> values, long long k) const;
+
+    /**
+     * @brief Returns a value whose rank is close to a quantile.
+     *
+     * The values are inserted into a soft heap and ceil(q * n) of them are
+     * extracted; the largest extracted value has a rank between q * n and
+     * (q + errorRate) * n. A larger error rate is faster.
+     *
+     * @param values The values.
+     * @param q The quantile, between 0 and 1.
+     * @param errorRate The error rate of the soft heap, between 0 and 1.
+     * @return long long The value, 0 if values is empty.
+     */
+    long long approximateQuantile(const std::vector<long long>& values, double q, double errorRate) const;
+};
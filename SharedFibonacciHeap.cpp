@@ -0,0 +1,639 @@
+#include "SharedFibonacciHeap.h"
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint64_t sharedHeapMagic = 0x3250454842494653ULL;
+static const int maxSharedDegree = 64;
+
+/**
+ * @brief Bookkeeping stored at the start of the shared region.
+ */
+struct SharedHeapHeader {
+    uint64_t magic;             ///< Set once the region is fully initialised
+    int32_t capacity;           ///< Number of node slots in the region
+    int32_t minNode;            ///< Slot of the minimum node, -1 if empty
+    int32_t numNodes;           ///< Total number of nodes in the heap
+    int32_t freeList;           ///< First released slot, -1 if none
+    int32_t nextUnused;         ///< First slot that was never handed out
+    int32_t updating;           ///< 1 while an operation is changing the links
+    int32_t poisoned;           ///< 1 once a process died while updating, until repair
+    pthread_mutex_t mutex;      ///< Robust process-shared lock
+};
+
+/**
+ * @brief A node of the shared heap. Links are slot indices, -1 means none.
+ */
+struct SharedNode {
+    int64_t key;       ///< The key/value of the node
+    int32_t id;        ///< Caller supplied identifier
+    int32_t parent;    ///< Slot of the parent node
+    int32_t child;     ///< Slot of one of the children
+    int32_t left;      ///< Slot of the left sibling
+    int32_t right;     ///< Slot of the right sibling, next free slot when released
+    int32_t degree;    ///< Number of children
+    uint8_t marked;    ///< Indicates if the node lost a child
+    uint8_t inUse;     ///< Indicates if the slot holds a node of the heap
+};
+
+/**
+ * @brief Returns the size of a region holding the given number of nodes.
+ *
+ * @param capacity The number of node slots.
+ * @return size_t The size of the region in bytes.
+ */
+static size_t regionSize(int capacity) {
+    return sizeof(SharedHeapHeader) + size_t(capacity) * sizeof(SharedNode);
+}
+
+/**
+ * @brief Wraps an already mapped region.
+ *
+ * @param region The start of the mapping.
+ * @param bytes The size of the mapping.
+ */
+SharedFibonacciHeap::SharedFibonacciHeap(void* region, size_t bytes)
+    : header(static_cast<SharedHeapHeader*>(region)),
+    nodes(reinterpret_cast<SharedNode*>(static_cast<char*>(region) + sizeof(SharedHeapHeader))),
+    mappedBytes(bytes) {}
+
+/**
+ * @brief Creates a new shared heap region.
+ *
+ * @param name The POSIX shared-memory name, e.g. "/jobs".
+ * @param capacity The maximum number of nodes in the heap.
+ * @return SharedFibonacciHeap* The heap, or nullptr if the region exists or cannot be created.
+ */
+SharedFibonacciHeap* SharedFibonacciHeap::create(const std::string& name, int capacity) {
+    if (capacity <= 0) {
+        std::cout << "Creating the shared heap failed, because the capacity must be positive.\n";
+        return nullptr;
+    }
+
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cout << "Creating the shared heap failed, because " << name << " cannot be created.\n";
+        return nullptr;
+    }
+
+    size_t bytes = regionSize(capacity);
+    if (::ftruncate(fd, off_t(bytes)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        std::cout << "Creating the shared heap failed, because " << name << " cannot be sized.\n";
+        return nullptr;
+    }
+
+    void* region = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        ::shm_unlink(name.c_str());
+        std::cout << "Creating the shared heap failed, because " << name << " cannot be mapped.\n";
+        return nullptr;
+    }
+
+    SharedHeapHeader* header = static_cast<SharedHeapHeader*>(region);
+    header->capacity = capacity;
+    header->minNode = -1;
+    header->numNodes = 0;
+    header->freeList = -1;
+    header->nextUnused = 0;
+    header->updating = 0;
+    header->poisoned = 0;
+
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&header->mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+
+    __atomic_store_n(&header->magic, sharedHeapMagic, __ATOMIC_RELEASE);
+    return new SharedFibonacciHeap(region, bytes);
+}
+
+/**
+ * @brief Opens a shared heap region created by another process.
+ *
+ * @param name The POSIX shared-memory name used in create.
+ * @return SharedFibonacciHeap* The heap, or nullptr if the region cannot be opened.
+ */
+SharedFibonacciHeap* SharedFibonacciHeap::open(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        std::cout << "Opening the shared heap failed, because " << name << " does not exist.\n";
+        return nullptr;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(SharedHeapHeader)) {
+        ::close(fd);
+        std::cout << "Opening the shared heap failed, because " << name << " is not initialised.\n";
+        return nullptr;
+    }
+
+    size_t bytes = size_t(info.st_size);
+    void* region = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        std::cout << "Opening the shared heap failed, because " << name << " cannot be mapped.\n";
+        return nullptr;
+    }
+
+    SharedHeapHeader* header = static_cast<SharedHeapHeader*>(region);
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != sharedHeapMagic
+        || regionSize(header->capacity) != bytes) {
+        ::munmap(region, bytes);
+        std::cout << "Opening the shared heap failed, because " << name << " is not initialised.\n";
+        return nullptr;
+    }
+    return new SharedFibonacciHeap(region, bytes);
+}
+
+/**
+ * @brief Removes the name of a shared heap region.
+ *
+ * @param name The POSIX shared-memory name used in create.
+ */
+void SharedFibonacciHeap::remove(const std::string& name) {
+    ::shm_unlink(name.c_str());
+}
+
+/**
+ * @brief Unmaps the region from this process.
+ */
+SharedFibonacciHeap::~SharedFibonacciHeap() {
+    ::munmap(this->header, this->mappedBytes);
+}
+
+/**
+ * @brief Locks the region mutex, recovering it if its owner died.
+ *
+ * @param operation The operation taking the lock, for messages.
+ * @param allowPoisoned True to take the lock even if the region is poisoned.
+ * @return bool True if the lock is held, false otherwise.
+ */
+bool SharedFibonacciHeap::lock(const char* operation, bool allowPoisoned) const {
+    int result = pthread_mutex_lock(&this->header->mutex);
+    if (result == EOWNERDEAD) {
+        // The previous owner died while holding the lock. If it was in the
+        // middle of changing the links, the rings may be half spliced, so the
+        // region is poisoned until repair rebuilds it from the slots.
+        if (this->header->updating != 0) {
+            __atomic_store_n(&this->header->poisoned, 1, __ATOMIC_RELEASE);
+        }
+        result = pthread_mutex_consistent(&this->header->mutex);
+        if (result != 0) {
+            pthread_mutex_unlock(&this->header->mutex);
+        }
+    }
+    if (result != 0) {
+        std::cout << operation << " failed, because the shared heap lock cannot be taken (error " << result << ").\n";
+        return false;
+    }
+    if (this->header->poisoned != 0 && !allowPoisoned) {
+        pthread_mutex_unlock(&this->header->mutex);
+        std::cout << operation << " failed, because a process died while updating the shared heap. Call repair first.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Unlocks the region mutex.
+ */
+void SharedFibonacciHeap::unlock() const {
+    pthread_mutex_unlock(&this->header->mutex);
+}
+
+/**
+ * @brief Marks the start or the end of a change to the links.
+ *
+ * @param active True before the first change, false after the last one.
+ */
+void SharedFibonacciHeap::setUpdating(bool active) {
+    // A killed process leaves its stores in program order, so only the
+    // compiler can misplace the flag. The store alone is a release, which
+    // keeps earlier changes before it but lets later ones move above it, so
+    // compiler fences on both sides pin it between the changes.
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    __atomic_store_n(&this->header->updating, active ? 1 : 0, __ATOMIC_SEQ_CST);
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Takes a slot from the free list.
+ *
+ * @return int The slot index, or -1 if the region is full.
+ */
+int SharedFibonacciHeap::allocateSlot() {
+    int slot = this->header->freeList;
+    if (slot != -1) {
+        this->header->freeList = this->nodes[slot].right;
+    }
+    else if (this->header->nextUnused < this->header->capacity) {
+        slot = this->header->nextUnused;
+        this->header->nextUnused += 1;
+    }
+    return slot;
+}
+
+/**
+ * @brief Returns a slot to the free list.
+ *
+ * @param slot The slot to be released.
+ */
+void SharedFibonacciHeap::releaseSlot(int slot) {
+    this->nodes[slot].inUse = 0;
+    this->nodes[slot].right = this->header->freeList;
+    this->header->freeList = slot;
+}
+
+/**
+ * @brief Inserts node x into the root list next to the minimum node.
+ *
+ * @param x The slot of the node to be added.
+ */
+void SharedFibonacciHeap::addRoot(int x) {
+    SharedNode& node = this->nodes[x];
+    node.parent = -1;
+    int minNode = this->header->minNode;
+    if (minNode == -1) {
+        node.left = x;
+        node.right = x;
+        this->header->minNode = x;
+        return;
+    }
+
+    SharedNode& minimum = this->nodes[minNode];
+    node.right = minNode;
+    node.left = minimum.left;
+    this->nodes[minimum.left].right = x;
+    minimum.left = x;
+}
+
+/**
+ * @brief Restructures the heap so that there is one tree of each degree.
+ */
+void SharedFibonacciHeap::consolidate() {
+    int degreeTable[maxSharedDegree];
+    for (int d = 0; d < maxSharedDegree; d++) {
+        degreeTable[d] = -1;
+    }
+
+    // Linking removes roots from the ring, so count them before walking it.
+    int rootCount = 0;
+    int current = this->header->minNode;
+    do {
+        rootCount += 1;
+        current = this->nodes[current].right;
+    } while (current != this->header->minNode);
+
+    for (int i = 0; i < rootCount; i++) {
+        int x = current;
+        current = this->nodes[current].right;
+        int d = this->nodes[x].degree;
+
+        while (degreeTable[d] != -1) {
+            int y = degreeTable[d];
+            if (this->nodes[x].key > this->nodes[y].key) {
+                std::swap(x, y);
+            }
+            this->link(y, x);
+            degreeTable[d] = -1;
+            d += 1;
+        }
+        degreeTable[d] = x;
+    }
+
+    this->header->minNode = -1;
+    for (int d = 0; d < maxSharedDegree; d++) {
+        int x = degreeTable[d];
+        if (x == -1) {
+            continue;
+        }
+        this->addRoot(x);
+        if (this->nodes[x].key < this->nodes[this->header->minNode].key) {
+            this->header->minNode = x;
+        }
+    }
+}
+
+/**
+ * @brief Links root y as a child of root x.
+ *
+ * @param y The slot of the node to be linked.
+ * @param x The slot of the node to which y will be linked.
+ */
+void SharedFibonacciHeap::link(int y, int x) {
+    SharedNode& child = this->nodes[y];
+    SharedNode& parent = this->nodes[x];
+
+    this->nodes[child.left].right = child.right;
+    this->nodes[child.right].left = child.left;
+
+    if (parent.child == -1) {
+        parent.child = y;
+        child.left = y;
+        child.right = y;
+    }
+    else {
+        SharedNode& first = this->nodes[parent.child];
+        child.right = parent.child;
+        child.left = first.left;
+        this->nodes[first.left].right = y;
+        first.left = y;
+    }
+
+    child.parent = x;
+    child.marked = 0;
+    parent.degree += 1;
+}
+
+/**
+ * @brief Cuts node x from its parent y and adds it to the root list.
+ *
+ * @param x The slot of the node to be cut.
+ * @param y The slot of the parent node.
+ */
+void SharedFibonacciHeap::cut(int x, int y) {
+    SharedNode& child = this->nodes[x];
+    SharedNode& parent = this->nodes[y];
+
+    if (child.right == x) {
+        parent.child = -1;
+    }
+    else {
+        this->nodes[child.left].right = child.right;
+        this->nodes[child.right].left = child.left;
+        if (parent.child == x) {
+            parent.child = child.right;
+        }
+    }
+    parent.degree -= 1;
+
+    this->addRoot(x);
+    child.marked = 0;
+}
+
+/**
+ * @brief Performs a cascading cut starting at node y.
+ *
+ * @param y The slot of the node on which to perform the cascading cut.
+ */
+void SharedFibonacciHeap::cascadingCut(int y) {
+    int z = this->nodes[y].parent;
+    while (z != -1) {
+        if (!this->nodes[y].marked) {
+            this->nodes[y].marked = 1;
+            return;
+        }
+        this->cut(y, z);
+        y = z;
+        z = this->nodes[y].parent;
+    }
+}
+
+/**
+ * @brief Inserts a new node with the given value into the heap.
+ *
+ * @param value The value of the new node.
+ * @param id Optional identifier stored in the new node (-1 if unused).
+ * @return int The slot of the new node, usable with decreaseKey, or -1 if the heap is full.
+ */
+int SharedFibonacciHeap::insert(long long value, int id) {
+    if (!this->lock("Inserting")) {
+        return -1;
+    }
+    this->setUpdating(true);
+    int x = this->allocateSlot();
+    if (x != -1) {
+        SharedNode& node = this->nodes[x];
+        node.key = value;
+        node.id = id;
+        node.child = -1;
+        node.degree = 0;
+        node.marked = 0;
+        node.inUse = 1;
+        this->addRoot(x);
+
+        if (value < this->nodes[this->header->minNode].key) {
+            this->header->minNode = x;
+        }
+        this->header->numNodes += 1;
+    }
+    this->setUpdating(false);
+    this->unlock();
+
+    if (x == -1) {
+        std::cout << "Inserting failed, because the shared heap is full.\n";
+    }
+    return x;
+}
+
+/**
+ * @brief Removes the node with the minimum key.
+ *
+ * @param key Set to the key of the removed node.
+ * @param id Set to the id of the removed node.
+ * @return bool True if a node was removed, false if the heap was empty.
+ */
+bool SharedFibonacciHeap::extractMin(long long& key, int& id) {
+    if (!this->lock("Extracting the minimum")) {
+        return false;
+    }
+    int z = this->header->minNode;
+    if (z == -1) {
+        this->unlock();
+        return false;
+    }
+    this->setUpdating(true);
+
+    SharedNode& zNode = this->nodes[z];
+    int child = zNode.child;
+    if (child != -1) {
+        // Clear the parents, then splice the whole child ring into the root ring.
+        int current = child;
+        do {
+            this->nodes[current].parent = -1;
+            current = this->nodes[current].right;
+        } while (current != child);
+
+        int childLast = this->nodes[child].left;
+        int zRight = zNode.right;
+        zNode.right = child;
+        this->nodes[child].left = z;
+        this->nodes[childLast].right = zRight;
+        this->nodes[zRight].left = childLast;
+        zNode.child = -1;
+    }
+
+    this->nodes[zNode.left].right = zNode.right;
+    this->nodes[zNode.right].left = zNode.left;
+
+    if (zNode.right == z) {
+        this->header->minNode = -1;
+    }
+    else {
+        this->header->minNode = zNode.right;
+        this->consolidate();
+    }
+    this->header->numNodes -= 1;
+
+    key = zNode.key;
+    id = zNode.id;
+    this->releaseSlot(z);
+    this->setUpdating(false);
+    this->unlock();
+    return true;
+}
+
+/**
+ * @brief Decreases the key of the node in the given slot.
+ *
+ * @param slot The slot returned by insert.
+ * @param newKey The new, smaller key value.
+ */
+void SharedFibonacciHeap::decreaseKey(int slot, long long newKey) {
+    if (!this->lock("Decreasing the key")) {
+        return;
+    }
+    if (slot < 0 || slot >= this->header->capacity || !this->nodes[slot].inUse) {
+        this->unlock();
+        std::cout << "Decreasing the key failed, because the slot is not in the heap.\n";
+        return;
+    }
+
+    SharedNode& x = this->nodes[slot];
+    if (newKey > x.key) {
+        this->unlock();
+        std::cout << "Decreasing the key failed, because the new key is greater than the current key.\n";
+        return;
+    }
+
+    this->setUpdating(true);
+    x.key = newKey;
+    int y = x.parent;
+    if (y != -1 && x.key < this->nodes[y].key) {
+        this->cut(slot, y);
+        this->cascadingCut(y);
+    }
+    if (x.key < this->nodes[this->header->minNode].key) {
+        this->header->minNode = slot;
+    }
+    this->setUpdating(false);
+    this->unlock();
+}
+
+/**
+ * @brief Checks if the heap is empty.
+ *
+ * @return True if the heap is empty or unusable, false otherwise.
+ */
+bool SharedFibonacciHeap::isEmpty() const {
+    if (!this->lock("Checking for emptiness")) {
+        return true;
+    }
+    bool empty = this->header->minNode == -1;
+    this->unlock();
+    return empty;
+}
+
+/**
+ * @brief Returns the minimum value in the heap.
+ *
+ * @return long long The minimum value in the heap, 0 if the heap is empty or unusable.
+ */
+long long SharedFibonacciHeap::getMinValue() const {
+    if (!this->lock("Reading the minimum")) {
+        return 0;
+    }
+    int minNode = this->header->minNode;
+    long long value = minNode == -1 ? 0 : this->nodes[minNode].key;
+    this->unlock();
+    return value;
+}
+
+/**
+ * @brief Returns the number of nodes in the heap.
+ *
+ * @return int The number of nodes in the heap, 0 if the heap is unusable.
+ */
+int SharedFibonacciHeap::getSize() const {
+    if (!this->lock("Reading the size")) {
+        return 0;
+    }
+    int size = this->header->numNodes;
+    this->unlock();
+    return size;
+}
+
+/**
+ * @brief Rebuilds a poisoned heap from its slots.
+ *
+ * @return bool True if the heap is usable again, false if the lock cannot be taken.
+ */
+bool SharedFibonacciHeap::repair() {
+    if (!this->lock("Repairing", true)) {
+        return false;
+    }
+    this->setUpdating(true);
+
+    // The slots themselves are intact: a slot is marked in use only after its
+    // key and id are written, and released only after its node left the heap.
+    // Every node in use becomes a root of its own and the free list is rebuilt.
+    this->header->minNode = -1;
+    this->header->numNodes = 0;
+    this->header->freeList = -1;
+    for (int slot = this->header->nextUnused - 1; slot >= 0; slot--) {
+        SharedNode& node = this->nodes[slot];
+        if (!node.inUse) {
+            this->releaseSlot(slot);
+            continue;
+        }
+        node.child = -1;
+        node.degree = 0;
+        node.marked = 0;
+        this->addRoot(slot);
+        if (node.key < this->nodes[this->header->minNode].key) {
+            this->header->minNode = slot;
+        }
+        this->header->numNodes += 1;
+    }
+
+    __atomic_store_n(&this->header->poisoned, 0, __ATOMIC_RELEASE);
+    this->setUpdating(false);
+    this->unlock();
+    return true;
+}
+
+/**
+ * @brief Returns whether a process died while updating the heap.
+ *
+ * @return bool True if every operation fails until repair is called, false otherwise.
+ */
+bool SharedFibonacciHeap::isPoisoned() const {
+    // A dead owner is only noticed by the next process taking the lock, so
+    // reading the flag without it would miss a process that just died.
+    if (!this->lock("Checking for poisoning", true)) {
+        return false;
+    }
+    bool poisoned = this->header->poisoned != 0;
+    this->unlock();
+    return poisoned;
+}
+
+/**
+ * @brief Returns the maximum number of nodes in the heap.
+ *
+ * @return int The capacity of the region.
+ */
+int SharedFibonacciHeap::getCapacity() const {
+    return this->header->capacity;
+}
@@ -0,0 +1,215 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+struct SharedHeapHeader;
+struct SharedNode;
+
+/**
+ * @class SharedFibonacciHeap
+ * @brief A Fibonacci Heap living in a POSIX shared-memory region.
+ *
+ * All nodes are stored in a fixed array inside the region and link to each
+ * other by slot index instead of by pointer, so every process can map the
+ * region at a different address. Free slots are kept in a free list inside the
+ * region. Every operation holds a robust process-shared mutex, so producers and
+ * consumers in separate processes can use the same heap directly.
+ *
+ * If a process dies while holding the lock in the middle of changing the
+ * links, the region is marked poisoned and every operation fails with a
+ * message until one process calls repair, which rebuilds the heap from the
+ * node slots. A process that dies while only reading does not poison it.
+ */
+class SharedFibonacciHeap
+{
+private:
+    SharedHeapHeader* header;   ///< Start of the mapped region
+    SharedNode* nodes;          ///< Node slots following the header
+    size_t mappedBytes;         ///< Size of the mapping
+
+    /**
+     * @brief Wraps an already mapped region.
+     *
+     * @param region The start of the mapping.
+     * @param bytes The size of the mapping.
+     */
+    SharedFibonacciHeap(void* region, size_t bytes);
+
+    /**
+     * @brief Locks the region mutex, recovering it if its owner died.
+     *
+     * If the owner died while updating, the region is marked poisoned. Errors
+     * are reported on the standard output with the name of the operation.
+     *
+     * @param operation The operation taking the lock, for messages.
+     * @param allowPoisoned True to take the lock even if the region is poisoned.
+     * @return bool True if the lock is held, false otherwise.
+     */
+    bool lock(const char* operation, bool allowPoisoned = false) const;
+
+    /**
+     * @brief Unlocks the region mutex.
+     */
+    void unlock() const;
+
+    /**
+     * @brief Marks the start or the end of a change to the links.
+     *
+     * @param active True before the first change, false after the last one.
+     */
+    void setUpdating(bool active);
+
+    /**
+     * @brief Takes a slot from the free list.
+     *
+     * @return int The slot index, or -1 if the region is full.
+     */
+    int allocateSlot();
+
+    /**
+     * @brief Returns a slot to the free list.
+     *
+     * @param slot The slot to be released.
+     */
+    void releaseSlot(int slot);
+
+    /**
+     * @brief Inserts node x into the root list next to the minimum node.
+     *
+     * @param x The slot of the node to be added.
+     */
+    void addRoot(int x);
+
+    /**
+     * @brief Restructures the heap so that there is one tree of each degree.
+     */
+    void consolidate();
+
+    /**
+     * @brief Links root y as a child of root x.
+     *
+     * @param y The slot of the node to be linked.
+     * @param x The slot of the node to which y will be linked.
+     */
+    void link(int y, int x);
+
+    /**
+     * @brief Cuts node x from its parent y and adds it to the root list.
+     *
+     * @param x The slot of the node to be cut.
+     * @param y The slot of the parent node.
+     */
+    void cut(int x, int y);
+
+    /**
+     * @brief Performs a cascading cut starting at node y.
+     *
+     * @param y The slot of the node on which to perform the cascading cut.
+     */
+    void cascadingCut(int y);
+
+public:
+    /**
+     * @brief Creates a new shared heap region.
+     *
+     * @param name The POSIX shared-memory name, e.g. "/jobs".
+     * @param capacity The maximum number of nodes in the heap.
+     * @return SharedFibonacciHeap* The heap, or nullptr if the region exists or cannot be created.
+     */
+    static SharedFibonacciHeap* create(const std::string& name, int capacity);
+
+    /**
+     * @brief Opens a shared heap region created by another process.
+     *
+     * @param name The POSIX shared-memory name used in create.
+     * @return SharedFibonacciHeap* The heap, or nullptr if the region cannot be opened.
+     */
+    static SharedFibonacciHeap* open(const std::string& name);
+
+    /**
+     * @brief Removes the name of a shared heap region.
+     *
+     * Processes that already mapped the region keep using it.
+     *
+     * @param name The POSIX shared-memory name used in create.
+     */
+    static void remove(const std::string& name);
+
+    /**
+     * @brief Unmaps the region from this process.
+     */
+    ~SharedFibonacciHeap();
+
+    /**
+     * @brief Inserts a new node with the given value into the heap.
+     *
+     * @param value The value of the new node.
+     * @param id Optional identifier stored in the new node (-1 if unused).
+     * @return int The slot of the new node, usable with decreaseKey, or -1 if the heap is full or unusable.
+     */
+    int insert(long long value, int id = -1);
+
+    /**
+     * @brief Removes the node with the minimum key.
+     *
+     * @param key Set to the key of the removed node.
+     * @param id Set to the id of the removed node.
+     * @return bool True if a node was removed, false if the heap was empty or unusable.
+     */
+    bool extractMin(long long& key, int& id);
+
+    /**
+     * @brief Decreases the key of the node in the given slot.
+     *
+     * @param slot The slot returned by insert.
+     * @param newKey The new, smaller key value.
+     */
+    void decreaseKey(int slot, long long newKey);
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return True if the heap is empty or unusable, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the minimum value in the heap.
+     *
+     * @return long long The minimum value in the heap, 0 if the heap is empty or unusable.
+     */
+    long long getMinValue() const;
+
+    /**
+     * @brief Returns the number of nodes in the heap.
+     *
+     * @return int The number of nodes in the heap, 0 if the heap is unusable.
+     */
+    int getSize() const;
+
+    /**
+     * @brief Rebuilds a poisoned heap from its slots.
+     *
+     * Every node still in use becomes a root and the free list is rebuilt, so
+     * no element is lost; the next extractMin consolidates the roots again.
+     * The node that a dying process was extracting stays in the heap. Calling
+     * it on a heap that is not poisoned is allowed and only flattens the trees.
+     *
+     * @return bool True if the heap is usable again, false if the lock cannot be taken.
+     */
+    bool repair();
+
+    /**
+     * @brief Returns whether a process died while updating the heap.
+     *
+     * @return bool True if every operation fails until repair is called, false otherwise.
+     */
+    bool isPoisoned() const;
+
+    /**
+     * @brief Returns the maximum number of nodes in the heap.
+     *
+     * @return int The capacity of the region.
+     */
+    int getCapacity() const;
+};
@@ -0,0 +1,351 @@
+#include "ShortestPaths.h"
+#include "IndexedFibonacciHeap.h"
+#include "TaskExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Runs body(part) for every part in [0, parts), part 0 on the calling thread.
+ *
+ * The other parts are submitted to the executor, whose threads persist across
+ * calls, so a phase costs a few task submissions instead of starting threads.
+ *
+ * @param executor The worker pool, nullptr to run every part on the calling thread.
+ * @param parts The number of parts.
+ * @param body The work for one part.
+ */
+static void runParts(TaskExecutor* executor, int parts, const std::function<void(int)>& body) {
+    if (executor == nullptr || parts <= 1) {
+        for (int part = 0; part < parts; part++) {
+            body(part);
+        }
+        return;
+    }
+    for (int part = 1; part < parts; part++) {
+        if (executor->submit(0, [&body, part]() { body(part); }).slot == -1) {
+            body(part);
+        }
+    }
+    body(0);
+    executor->wait();
+}
+
+/**
+ * @brief Runs body(thread, begin, end) over [0, count) split between threads.
+ *
+ * Small ranges run on the calling thread alone, where handing out work would
+ * cost more than it saves.
+ *
+ * @param executor The worker pool, nullptr to run on the calling thread.
+ * @param count The size of the range.
+ * @param threads The number of threads.
+ * @param body The work for one part of the range.
+ */
+static void parallelFor(TaskExecutor* executor, size_t count, int threads,
+    const std::function<void(int, size_t, size_t)>& body) {
+    const size_t minimumPerThread = 1024;
+    int used = int(std::min<size_t>(size_t(threads), (count + minimumPerThread - 1) / minimumPerThread));
+    if (used <= 1) {
+        body(0, 0, count);
+        return;
+    }
+
+    size_t part = (count + size_t(used) - 1) / size_t(used);
+    runParts(executor, used, [&](int t) {
+        size_t begin = std::min(count, part * size_t(t));
+        body(t, begin, std::min(count, begin + part));
+    });
+}
+
+/**
+ * @brief Builds a CSR graph from a list of edges.
+ *
+ * @param vertexCount The number of vertices.
+ * @param sources The source vertex of every edge.
+ * @param targets The target vertex of every edge.
+ * @param weights The non-negative weight of every edge.
+ * @return CsrGraph The graph.
+ */
+CsrGraph ShortestPaths::buildGraph(int vertexCount, const std::vector<int>& sources,
+    const std::vector<int>& targets, const std::vector<int>& weights) const {
+    CsrGraph graph;
+    graph.vertexCount = vertexCount;
+    graph.offsets.assign(size_t(vertexCount) + 1, 0);
+    graph.targets.resize(sources.size());
+    graph.weights.resize(sources.size());
+
+    for (int source : sources) {
+        graph.offsets[size_t(source) + 1] += 1;
+    }
+    for (int v = 0; v < vertexCount; v++) {
+        graph.offsets[size_t(v) + 1] += graph.offsets[v];
+    }
+
+    std::vector<long long> position(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (size_t e = 0; e < sources.size(); e++) {
+        long long at = position[sources[e]]++;
+        graph.targets[at] = targets[e];
+        graph.weights[at] = weights[e];
+    }
+    return graph;
+}
+
+/**
+ * @brief Computes distances with Dijkstra's algorithm on a Fibonacci Heap.
+ *
+ * @param graph The graph.
+ * @param source The source vertex.
+ * @return std::vector<int> The distance of every vertex from the source.
+ */
+std::vector<int> ShortestPaths::dijkstra(const CsrGraph& graph, int source) const {
+    std::vector<int> distance(size_t(graph.vertexCount), INT_MAX);
+    IndexedFibonacciHeap heap(graph.vertexCount);
+
+    distance[source] = 0;
+    heap.upsert(source, 0);
+    while (!heap.isEmpty()) {
+        int u = heap.extractMin();
+        for (long long e = graph.offsets[u]; e < graph.offsets[size_t(u) + 1]; e++) {
+            int v = graph.targets[e];
+            long long candidate = (long long)distance[u] + graph.weights[e];
+            if (candidate < distance[v]) {
+                distance[v] = int(candidate);
+                heap.upsert(v, distance[v]);
+            }
+        }
+    }
+    return distance;
+}
+
+/**
+ * @brief Computes distances with parallel delta-stepping.
+ *
+ * @param graph The graph.
+ * @param source The source vertex.
+ * @param delta The bucket width, at least 1.
+ * @param threads The number of threads, at least 1.
+ * @return std::vector<int> The distance of every vertex from the source.
+ */
+std::vector<int> ShortestPaths::deltaStepping(const CsrGraph& graph, int source, int delta, int threads) const {
+    delta = std::max(delta, 1);
+    threads = std::max(threads, 1);
+
+    size_t vertexCount = size_t(graph.vertexCount);
+    std::vector<std::atomic<int>> distance(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        distance[v].store(INT_MAX, std::memory_order_relaxed);
+    }
+
+    // A request from bucket i lands at most ceil(maxWeight / delta) buckets
+    // further, so a ring of that many buckets plus the current one holds every
+    // pending bucket, with bucket b in slot b % ringSize. The ring is capped,
+    // and requests beyond its reach wait in an overflow list until the ring
+    // gets to them, so the memory does not depend on the size of the weights.
+    const size_t maxRingSize = size_t(1) << 16;
+    int maxWeight = 0;
+    for (int w : graph.weights) {
+        maxWeight = std::max(maxWeight, w);
+    }
+    size_t ringSize = std::min(size_t((maxWeight + (long long)delta - 1) / delta) + 1, maxRingSize);
+
+    std::vector<std::vector<int>> ring(ringSize);
+    std::vector<std::pair<int, int>> overflow;
+    size_t overflowLowest = SIZE_MAX;
+    size_t queued = 1;
+    std::vector<std::vector<std::pair<int, int>>> requests(static_cast<size_t>(threads));
+    distance[source].store(0);
+    ring[0].push_back(source);
+
+    // One pool for the whole run; the calling thread takes the first part of
+    // every phase, so threads - 1 workers are enough.
+    std::unique_ptr<TaskExecutor> executor;
+    if (threads > 1) {
+        executor.reset(new TaskExecutor(threads - 1));
+    }
+
+    // Relaxes the light or heavy edges of the given vertices. Every improved
+    // vertex is recorded with its new bucket in the thread's own buffer.
+    auto relax = [&](const std::vector<int>& vertices, bool light) {
+        parallelFor(executor.get(), vertices.size(), threads, [&](int thread, size_t begin, size_t end) {
+            std::vector<std::pair<int, int>>& buffer = requests[thread];
+            for (size_t i = begin; i < end; i++) {
+                int u = vertices[i];
+                int du = distance[u].load(std::memory_order_relaxed);
+                for (long long e = graph.offsets[u]; e < graph.offsets[size_t(u) + 1]; e++) {
+                    int w = graph.weights[e];
+                    if ((w <= delta) != light) {
+                        continue;
+                    }
+                    long long candidate = (long long)du + w;
+                    if (candidate >= INT_MAX) {
+                        continue;
+                    }
+                    int v = graph.targets[e];
+                    int current = distance[v].load(std::memory_order_relaxed);
+                    while (candidate < current) {
+                        if (distance[v].compare_exchange_weak(current, int(candidate), std::memory_order_relaxed)) {
+                            buffer.emplace_back(int(candidate / delta), v);
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+    };
+
+    // Appends the buffered requests of every thread to the buckets. Large
+    // merges run in parallel: every thread counts its requests per bucket,
+    // prefix sums give each thread its own range at the end of every bucket,
+    // and the threads then copy their requests into those ranges. Requests
+    // past the end of the ring go to the overflow list on the calling thread.
+    std::vector<size_t> highest(static_cast<size_t>(threads));
+    std::vector<size_t> positions;
+    auto mergeRequests = [&](size_t current) {
+        size_t total = 0;
+        for (const std::vector<std::pair<int, int>>& buffer : requests) {
+            total += buffer.size();
+        }
+        if (executor == nullptr || total < 4096) {
+            for (std::vector<std::pair<int, int>>& buffer : requests) {
+                for (const std::pair<int, int>& request : buffer) {
+                    size_t b = size_t(request.first);
+                    if (b < current + ringSize) {
+                        ring[b % ringSize].push_back(request.second);
+                        queued += 1;
+                    }
+                    else {
+                        overflow.push_back(request);
+                        overflowLowest = std::min(overflowLowest, b);
+                    }
+                }
+                buffer.clear();
+            }
+            return;
+        }
+
+        // Requests never go below the current bucket, since distances only
+        // grow from the bucket being relaxed.
+        runParts(executor.get(), threads, [&](int t) {
+            size_t high = current;
+            for (const std::pair<int, int>& request : requests[t]) {
+                high = std::max(high, size_t(request.first));
+            }
+            highest[t] = high;
+        });
+        size_t requested = *std::max_element(highest.begin(), highest.end());
+        size_t high = std::min(requested, current + ringSize - 1);
+        size_t span = high - current + 1;
+        if (requested > high) {
+            for (const std::vector<std::pair<int, int>>& buffer : requests) {
+                for (const std::pair<int, int>& request : buffer) {
+                    if (size_t(request.first) > high) {
+                        overflow.push_back(request);
+                        overflowLowest = std::min(overflowLowest, size_t(request.first));
+                    }
+                }
+            }
+        }
+
+        positions.assign(size_t(threads) * span, 0);
+        runParts(executor.get(), threads, [&](int t) {
+            size_t* counts = &positions[size_t(t) * span];
+            for (const std::pair<int, int>& request : requests[t]) {
+                if (size_t(request.first) <= high) {
+                    counts[size_t(request.first) - current] += 1;
+                }
+            }
+        });
+        for (size_t b = 0; b < span; b++) {
+            std::vector<int>& bucket = ring[(current + b) % ringSize];
+            size_t end = bucket.size();
+            for (int t = 0; t < threads; t++) {
+                size_t count = positions[size_t(t) * span + b];
+                positions[size_t(t) * span + b] = end;
+                end += count;
+            }
+            queued += end - bucket.size();
+            bucket.resize(end);
+        }
+        runParts(executor.get(), threads, [&](int t) {
+            size_t* next = &positions[size_t(t) * span];
+            for (const std::pair<int, int>& request : requests[t]) {
+                if (size_t(request.first) <= high) {
+                    size_t b = size_t(request.first) - current;
+                    ring[(current + b) % ringSize][next[b]++] = request.second;
+                }
+            }
+            requests[t].clear();
+        });
+    };
+
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    size_t current = 0;
+    while (true) {
+        std::vector<int>& bucket = ring[current % ringSize];
+        settled.clear();
+        while (!bucket.empty()) {
+            frontier.clear();
+            for (int v : bucket) {
+                // Skip vertices that moved to an earlier bucket since they were added.
+                if (size_t(distance[v].load(std::memory_order_relaxed) / delta) == current) {
+                    frontier.push_back(v);
+                }
+            }
+            queued -= bucket.size();
+            bucket.clear();
+            std::sort(frontier.begin(), frontier.end());
+            frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            relax(frontier, true);
+            mergeRequests(current);
+        }
+
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        relax(settled, false);
+        mergeRequests(current);
+
+        if (queued == 0 && overflow.empty()) {
+            break;
+        }
+        // With the ring empty, jump straight to the lowest overflow bucket
+        // instead of stepping through the empty ones in between.
+        current = queued > 0 ? current + 1 : overflowLowest;
+
+        // Move the overflow requests the ring now reaches into it, in time for
+        // their buckets to be processed in order, and drop those whose vertex
+        // has moved to an earlier bucket since.
+        if (overflowLowest < current + ringSize) {
+            size_t kept = 0;
+            overflowLowest = SIZE_MAX;
+            for (const std::pair<int, int>& request : overflow) {
+                size_t b = size_t(request.first);
+                if (size_t(distance[request.second].load(std::memory_order_relaxed) / delta) != b) {
+                    continue;
+                }
+                if (b < current + ringSize) {
+                    ring[b % ringSize].push_back(request.second);
+                    queued += 1;
+                }
+                else {
+                    overflow[kept++] = request;
+                    overflowLowest = std::min(overflowLowest, b);
+                }
+            }
+            overflow.resize(kept);
+        }
+    }
+
+    std::vector<int> result(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        result[v] = distance[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+
+/**
+ * @struct CsrGraph
+ * @brief A directed graph with non-negative integer weights in compressed sparse row form.
+ *
+ * The edges leaving vertex v are at positions offsets[v] to offsets[v + 1] - 1
+ * of targets and weights.
+ */
+struct CsrGraph {
+    int vertexCount;                 ///< Number of vertices
+    std::vector<long long> offsets;  ///< First edge of every vertex, vertexCount + 1 entries
+    std::vector<int> targets;        ///< Target vertex of every edge
+    std::vector<int> weights;        ///< Weight of every edge
+};
+
+/**
+ * @class ShortestPaths
+ * @brief Single-source shortest paths on CSR graphs.
+ *
+ * dijkstra is the sequential reference built on the indexed Fibonacci Heap.
+ * deltaStepping groups tentative distances into buckets of width delta and
+ * relaxes the edges of a bucket on several threads with atomic distance
+ * updates. Distances that cannot be reached are INT_MAX.
+ */
+class ShortestPaths {
+public:
+    /**
+     * @brief Builds a CSR graph from a list of edges.
+     *
+     * @param vertexCount The number of vertices.
+     * @param sources The source vertex of every edge.
+     * @param targets The target vertex of every edge.
+     * @param weights The non-negative weight of every edge.
+     * @return CsrGraph The graph.
+     */
+    CsrGraph buildGraph(int vertexCount, const std::vector<int>& sources,
+        const std::vector<int>& targets, const std::vector<int>& weights) const;
+
+    /**
+     * @brief Computes distances with Dijkstra's algorithm on a Fibonacci Heap.
+     *
+     * @param graph The graph.
+     * @param source The source vertex.
+     * @return std::vector<int> The distance of every vertex from the source.
+     */
+    std::vector<int> dijkstra(const CsrGraph& graph, int source) const;
+
+    /**
+     * @brief Computes distances with parallel delta-stepping.
+     *
+     * Edges not heavier than delta are light and are relaxed repeatedly until
+     * the current bucket stays empty; heavy edges are relaxed once per bucket.
+     * Every thread collects the vertices it improved in its own buffer, and the
+     * buffers are merged into the buckets between phases, in parallel when they
+     * are large. The phases run on one TaskExecutor created for the whole call.
+     * The buckets form a ring of ceil(maxWeight / delta) + 1 buckets, capped at
+     * 65536, and requests beyond the ring wait in an overflow list, so memory
+     * depends on neither the distances nor the weights.
+     *
+     * @param graph The graph.
+     * @param source The source vertex.
+     * @param delta The bucket width, at least 1.
+     * @param threads The number of threads, at least 1.
+     * @return std::vector<int> The distance of every vertex from the source.
+     */
+    std::vector<int> deltaStepping(const CsrGraph& graph, int source, int delta, int threads) const;
+};
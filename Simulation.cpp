@@ -0,0 +1,289 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+static const int eventFree = 0;
+static const int eventQueued = 1;
+static const int eventDue = 2;
+
+/**
+ * @brief Constructs a simulation at time 0 with no events.
+ */
+Simulation::Simulation()
+    : now(0), nextSequence(0), processedCount(0), pendingCount(0) {}
+
+/**
+ * @brief Destroys the simulation and the nodes of all slots.
+ */
+Simulation::~Simulation() {
+    // The nodes belong to the slots, so the heap must not delete them.
+    this->futureEvents.minNode = nullptr;
+    this->futureEvents.numNodes = 0;
+}
+
+/**
+ * @brief Registers the handler of an event type, replacing any previous one.
+ *
+ * @param type The event type, a small non-negative integer.
+ * @param handler The function called for every event of the type.
+ */
+void Simulation::setHandler(int type, std::function<void(Simulation&, const Event&)> handler) {
+    if (type < 0) {
+        std::cout << "Setting the handler failed, because the event type is negative.\n";
+        return;
+    }
+    if (size_t(type) >= this->handlers.size()) {
+        this->handlers.resize(size_t(type) + 1);
+    }
+    this->handlers[type] = std::move(handler);
+}
+
+/**
+ * @brief Returns the record of a handle if the handle is still valid.
+ *
+ * @param handle The handle to be checked.
+ * @return EventRecord* The record, nullptr if the event was processed or cancelled.
+ */
+Simulation::EventRecord* Simulation::find(EventHandle handle) {
+    if (handle.slot < 0 || size_t(handle.slot) >= this->pool.size()) {
+        return nullptr;
+    }
+    EventRecord& record = this->pool[handle.slot];
+    if (record.generation != handle.generation || record.state == eventFree) {
+        return nullptr;
+    }
+    return &record;
+}
+
+/**
+ * @brief Returns a slot to the pool.
+ *
+ * @param slot The slot to be released.
+ */
+void Simulation::releaseSlot(int slot) {
+    EventRecord& record = this->pool[slot];
+    record.state = eventFree;
+    record.generation += 1;
+    this->freeSlots.push_back(slot);
+}
+
+/**
+ * @brief Schedules an event.
+ *
+ * @param time The absolute time of the event, not before the current time.
+ * @param type The type of the event.
+ * @param data The payload of the event.
+ * @return EventHandle The handle of the event, with slot -1 if the time is in the past.
+ */
+EventHandle Simulation::schedule(long long time, int type, int data) {
+    if (time < this->now) {
+        std::cout << "Scheduling the event failed, because its time is in the past.\n";
+        return EventHandle{ -1, 0 };
+    }
+
+    int slot;
+    if (!this->freeSlots.empty()) {
+        slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+    }
+    else {
+        slot = int(this->pool.size());
+        this->nodes.emplace_back(0, slot);
+        this->pool.push_back(EventRecord{ Event{ 0, 0, 0 }, 0, &this->nodes.back(), 0, eventFree });
+    }
+
+    EventRecord& record = this->pool[slot];
+    record.event = Event{ type, time, data };
+    record.sequence = this->nextSequence++;
+    record.node->setKey(time);
+    this->futureEvents.insertNode(record.node);
+    record.state = eventQueued;
+    this->pendingCount += 1;
+    return EventHandle{ slot, record.generation };
+}
+
+/**
+ * @brief Cancels a pending event.
+ *
+ * @param handle The handle returned by schedule.
+ * @return bool True if the event was pending and will not be processed.
+ */
+bool Simulation::cancel(EventHandle handle) {
+    EventRecord* record = this->find(handle);
+    if (record == nullptr) {
+        return false;
+    }
+
+    // A due event is already out of the heap; releasing the slot changes its
+    // generation, so step skips it.
+    if (record->state == eventQueued) {
+        this->futureEvents.removeNode(record->node);
+    }
+    this->releaseSlot(handle.slot);
+    this->pendingCount -= 1;
+    return true;
+}
+
+/**
+ * @brief Moves a pending event to another time.
+ *
+ * @param handle The handle returned by schedule.
+ * @param time The new absolute time, not before the current time.
+ * @return bool True if the event was pending and was moved.
+ */
+bool Simulation::reschedule(EventHandle handle, long long time) {
+    EventRecord* record = this->find(handle);
+    if (record == nullptr || time < this->now) {
+        return false;
+    }
+
+    record->event.time = time;
+    record->sequence = this->nextSequence++;
+    if (record->state == eventDue) {
+        record->node->setKey(time);
+        this->futureEvents.insertNode(record->node);
+        record->state = eventQueued;
+    }
+    else if (time <= record->node->getKey()) {
+        this->futureEvents.decreaseKey(record->node, time);
+    }
+    else {
+        this->futureEvents.increaseKey(record->node, time);
+    }
+    return true;
+}
+
+/**
+ * @brief Moves every event at the earliest time from the heap to the due list.
+ */
+void Simulation::collectDueEvents() {
+    long long time = this->futureEvents.getMinValue();
+    while (!this->futureEvents.isEmpty() && this->futureEvents.getMinValue() == time) {
+        Node* node = this->futureEvents.extractMin();
+        int slot = node->getId();
+
+        EventRecord& record = this->pool[slot];
+        record.state = eventDue;
+        this->due.push_back(DueEvent{ record.sequence, slot, record.generation });
+    }
+
+    std::sort(this->due.begin(), this->due.end(), [](const DueEvent& a, const DueEvent& b) {
+        return a.sequence > b.sequence;
+    });
+    this->now = time;
+}
+
+/**
+ * @brief Processes the next event.
+ *
+ * @return bool True if an event was processed, false if none was pending.
+ */
+bool Simulation::step() {
+    while (true) {
+        if (this->due.empty()) {
+            if (this->futureEvents.isEmpty()) {
+                return false;
+            }
+            this->collectDueEvents();
+        }
+
+        DueEvent next = this->due.back();
+        this->due.pop_back();
+        EventRecord& record = this->pool[next.slot];
+        if (record.generation != next.generation || record.state != eventDue
+            || record.sequence != next.sequence) {
+            continue;
+        }
+
+        // Copy the event, the pool may grow while the handler schedules more.
+        Event event = record.event;
+        this->releaseSlot(next.slot);
+        this->pendingCount -= 1;
+        this->processedCount += 1;
+
+        if (size_t(event.type) < this->handlers.size() && this->handlers[event.type]) {
+            this->handlers[event.type](*this, event);
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Processes events until none is pending or the next one is after a time.
+ *
+ * @param until The last time at which events are processed.
+ * @return long long The number of events processed by this call.
+ */
+long long Simulation::run(long long until) {
+    long long processed = 0;
+    while (true) {
+        if (this->due.empty()
+            && (this->futureEvents.isEmpty() || this->futureEvents.getMinValue() > until)) {
+            break;
+        }
+        if (!this->step()) {
+            break;
+        }
+        processed += 1;
+    }
+    return processed;
+}
+
+/**
+ * @brief Returns the current simulation time.
+ *
+ * @return long long The time of the last processed event.
+ */
+long long Simulation::getTime() const {
+    return this->now;
+}
+
+/**
+ * @brief Returns the number of events scheduled but not yet processed.
+ *
+ * @return int The number of pending events.
+ */
+int Simulation::getPendingCount() const {
+    return this->pendingCount;
+}
+
+/**
+ * @brief Returns the number of events processed so far.
+ *
+ * @return long long The number of processed events.
+ */
+long long Simulation::getProcessedCount() const {
+    return this->processedCount;
+}
+
+/**
+ * @brief Runs independent replications on several threads.
+ *
+ * @param count The number of replications.
+ * @param threads The number of threads to use.
+ * @param replication The function running one replication, given its index.
+ * @return std::vector<long long> The result of every replication, by index.
+ */
+std::vector<long long> Simulation::runReplications(int count, int threads,
+    std::function<long long(int)> replication) {
+    std::vector<long long> results(count > 0 ? size_t(count) : 0, 0);
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            results[i] = replication(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    int threadCount = std::max(1, std::min(threads, count));
+    for (int t = 1; t < threadCount; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
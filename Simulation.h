@@ -0,0 +1,191 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @struct Event
+ * @brief An event of a discrete-event simulation.
+ */
+struct Event {
+    int type;       ///< Selects the handler that processes the event
+    long long time; ///< Simulation time at which the event happens
+    int data;       ///< Payload for the handler
+};
+
+/**
+ * @struct EventHandle
+ * @brief Identifies a scheduled event so that it can be cancelled or rescheduled.
+ */
+struct EventHandle {
+    int slot;              ///< Slot of the event in the pool, -1 if scheduling failed
+    uint32_t generation;   ///< Generation of the slot when the event was scheduled
+};
+
+/**
+ * @class Simulation
+ * @brief A discrete-event simulation core with a Fibonacci Heap as the future event list.
+ *
+ * Events are kept in a pool of reusable slots. Every slot owns one node, with
+ * the slot as its id, which is linked into the heap keyed by the event time
+ * while the event is pending, so scheduling allocates nothing once the pool
+ * has grown to the number of pending events. Events at the same time are processed in the order they were scheduled, so runs are
+ * deterministic. Handlers are registered per event type and may schedule,
+ * cancel and reschedule other events.
+ */
+class Simulation
+{
+private:
+    /**
+     * @brief A pool slot holding one event.
+     */
+    struct EventRecord {
+        Event event;             ///< The event itself
+        long long sequence;      ///< Scheduling order, used to break ties in time
+        Node* node;              ///< Node of the slot, in the heap while the event is queued
+        uint32_t generation;     ///< Incremented each time the slot is released
+        int state;               ///< Free, Queued or Due
+    };
+
+    /**
+     * @brief An event taken from the heap that is due at the current time.
+     */
+    struct DueEvent {
+        long long sequence;      ///< Scheduling order of the event
+        int slot;                ///< Slot of the event
+        uint32_t generation;     ///< Generation of the slot when it was taken
+    };
+
+    FibonacciHeap futureEvents;                   ///< Pending events keyed by time
+    std::vector<EventRecord> pool;                ///< Event storage
+    std::deque<Node> nodes;                       ///< Heap node of every slot, by slot, at a stable address
+    std::vector<int> freeSlots;                   ///< Released slots of the pool
+    std::vector<DueEvent> due;                    ///< Events at the current time, latest sequence first
+    std::vector<std::function<void(Simulation&, const Event&)>> handlers; ///< Handlers by event type
+    long long now;                                ///< Current simulation time
+    long long nextSequence;                       ///< Sequence given to the next scheduled event
+    long long processedCount;                     ///< Number of events processed so far
+    int pendingCount;                             ///< Number of events scheduled but not processed
+
+    /**
+     * @brief Returns the record of a handle if the handle is still valid.
+     *
+     * @param handle The handle to be checked.
+     * @return EventRecord* The record, nullptr if the event was processed or cancelled.
+     */
+    EventRecord* find(EventHandle handle);
+
+    /**
+     * @brief Returns a slot to the pool.
+     *
+     * @param slot The slot to be released.
+     */
+    void releaseSlot(int slot);
+
+    /**
+     * @brief Moves every event at the earliest time from the heap to the due list.
+     */
+    void collectDueEvents();
+
+public:
+    /**
+     * @brief Constructs a simulation at time 0 with no events.
+     */
+    Simulation();
+
+    /**
+     * @brief Destroys the simulation and the nodes of all slots.
+     */
+    ~Simulation();
+
+    /**
+     * @brief Registers the handler of an event type, replacing any previous one.
+     *
+     * @param type The event type, a small non-negative integer.
+     * @param handler The function called for every event of the type.
+     */
+    void setHandler(int type, std::function<void(Simulation&, const Event&)> handler);
+
+    /**
+     * @brief Schedules an event.
+     *
+     * @param time The absolute time of the event, not before the current time.
+     * @param type The type of the event.
+     * @param data The payload of the event.
+     * @return EventHandle The handle of the event, with slot -1 if the time is in the past.
+     */
+    EventHandle schedule(long long time, int type, int data = 0);
+
+    /**
+     * @brief Cancels a pending event.
+     *
+     * @param handle The handle returned by schedule.
+     * @return bool True if the event was pending and will not be processed.
+     */
+    bool cancel(EventHandle handle);
+
+    /**
+     * @brief Moves a pending event to another time.
+     *
+     * The event is ordered as if it was scheduled now among events at the new time.
+     *
+     * @param handle The handle returned by schedule.
+     * @param time The new absolute time, not before the current time.
+     * @return bool True if the event was pending and was moved.
+     */
+    bool reschedule(EventHandle handle, long long time);
+
+    /**
+     * @brief Processes the next event.
+     *
+     * @return bool True if an event was processed, false if none was pending.
+     */
+    bool step();
+
+    /**
+     * @brief Processes events until none is pending or the next one is after a time.
+     *
+     * @param until The last time at which events are processed.
+     * @return long long The number of events processed by this call.
+     */
+    long long run(long long until = LLONG_MAX);
+
+    /**
+     * @brief Returns the current simulation time.
+     *
+     * @return long long The time of the last processed event.
+     */
+    long long getTime() const;
+
+    /**
+     * @brief Returns the number of events scheduled but not yet processed.
+     *
+     * @return int The number of pending events.
+     */
+    int getPendingCount() const;
+
+    /**
+     * @brief Returns the number of events processed so far.
+     *
+     * @return long long The number of processed events.
+     */
+    long long getProcessedCount() const;
+
+    /**
+     * @brief Runs independent replications on several threads.
+     *
+     * Each replication builds and runs its own Simulation inside the function,
+     * so replications never share state and give the same results as when run
+     * one after the other.
+     *
+     * @param count The number of replications.
+     * @param threads The number of threads to use.
+     * @param replication The function running one replication, given its index.
+     * @return std::vector<long long> The result of every replication, by index.
+     */
+    static std::vector<long long> runReplications(int count, int threads,
+        std::function<long long(int)> replication);
+};
@@ -0,0 +1,258 @@
+#include "SoftHeap.h"
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+/**
+ * @brief Constructs an empty soft heap.
+ *
+ * @param rate The fraction of insertions that may be corrupted, between 0 and 1.
+ */
+SoftHeap::SoftHeap(double rate) : firstRoot(-1), errorRate(rate), numItems(0) {
+    if (!(rate > 0.0 && rate < 1.0)) {
+        std::cout << "Setting the error rate failed, because it is not between 0 and 1; using 1/3.\n";
+        this->errorRate = 1.0 / 3.0;
+    }
+    this->rankThreshold = int(std::ceil(std::log2(3.0 / this->errorRate)));
+}
+
+/**
+ * @brief Takes a node slot and initializes it with an empty list.
+ *
+ * @param rank The rank of the node.
+ * @param size The number of items the list is filled up to.
+ * @return int The node.
+ */
+int SoftHeap::newNode(int rank, int size) {
+    int x;
+    if (!this->freeNodes.empty()) {
+        x = this->freeNodes.back();
+        this->freeNodes.pop_back();
+    }
+    else {
+        x = int(this->nodes.size());
+        this->nodes.push_back(SoftNode());
+    }
+    this->nodes[x] = SoftNode{ 0, -1, -1, -1, x, -1, -1, 0, size, rank };
+    return x;
+}
+
+/**
+ * @brief Checks whether a node has no children.
+ *
+ * @param x The node.
+ * @return bool True if the node is a leaf.
+ */
+bool SoftHeap::isLeaf(int x) const {
+    return this->nodes[x].left == -1 && this->nodes[x].right == -1;
+}
+
+/**
+ * @brief Refills the list of a node from its children.
+ *
+ * @param x The node.
+ */
+void SoftHeap::sift(int x) {
+    while (this->nodes[x].count < this->nodes[x].size && !this->isLeaf(x)) {
+        SoftNode& node = this->nodes[x];
+        if (node.left == -1
+            || (node.right != -1 && this->nodes[node.left].key > this->nodes[node.right].key)) {
+            std::swap(node.left, node.right);
+        }
+
+        // Move the whole list of the smaller child to the end of this list.
+        SoftNode& child = this->nodes[node.left];
+        if (node.last == -1) {
+            node.first = child.first;
+        }
+        else {
+            this->items[node.last].next = child.first;
+        }
+        node.last = child.last;
+        node.count += child.count;
+        node.key = child.key;
+        child.first = -1;
+        child.last = -1;
+        child.count = 0;
+
+        if (this->isLeaf(node.left)) {
+            this->freeNodes.push_back(node.left);
+            node.left = -1;
+        }
+        else {
+            this->sift(node.left);
+        }
+    }
+}
+
+/**
+ * @brief Makes a new node of the next rank with two roots of equal rank as children.
+ *
+ * @param x The first root.
+ * @param y The second root.
+ * @return int The new node.
+ */
+int SoftHeap::link(int x, int y) {
+    int rank = this->nodes[x].rank + 1;
+    int size = rank <= this->rankThreshold ? 1 : (3 * this->nodes[x].size + 1) / 2;
+    int z = this->newNode(rank, size);
+    this->nodes[z].left = x;
+    this->nodes[z].right = y;
+    this->sift(z);
+    return z;
+}
+
+/**
+ * @brief Recomputes the suffix minimum of a root and of every root before it.
+ *
+ * @param x The last root whose suffix minimum may have changed.
+ */
+void SoftHeap::updateSuffixMin(int x) {
+    // The root list is singly linked and short (one root per rank), so the
+    // roots up to x are collected and updated from x back to the front.
+    int prefix[64];
+    int length = 0;
+    for (int root = this->firstRoot; root != -1; root = this->nodes[root].next) {
+        prefix[length++] = root;
+        if (root == x) {
+            break;
+        }
+    }
+
+    for (int i = length - 1; i >= 0; i--) {
+        SoftNode& root = this->nodes[prefix[i]];
+        root.suffixMin = prefix[i];
+        if (root.next != -1) {
+            int after = this->nodes[root.next].suffixMin;
+            if (this->nodes[after].key < root.key) {
+                root.suffixMin = after;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Inserts an element.
+ *
+ * @param key The key of the element.
+ * @param id Optional identifier carried with the key (-1 if unused).
+ */
+void SoftHeap::insert(long long key, int id) {
+    int item;
+    if (!this->freeItems.empty()) {
+        item = this->freeItems.back();
+        this->freeItems.pop_back();
+    }
+    else {
+        item = int(this->items.size());
+        this->items.push_back(Item());
+    }
+    this->items[item] = Item{ key, id, -1 };
+
+    int x = this->newNode(0, 1);
+    SoftNode& node = this->nodes[x];
+    node.key = key;
+    node.first = item;
+    node.last = item;
+    node.count = 1;
+
+    // Add the rank 0 root at the front and link equal ranks like a binary counter.
+    node.next = this->firstRoot;
+    this->firstRoot = x;
+    while (this->nodes[this->firstRoot].next != -1
+        && this->nodes[this->firstRoot].rank == this->nodes[this->nodes[this->firstRoot].next].rank) {
+        int a = this->firstRoot;
+        int b = this->nodes[a].next;
+        int rest = this->nodes[b].next;
+        int z = this->link(a, b);
+        this->nodes[z].next = rest;
+        this->firstRoot = z;
+    }
+    this->updateSuffixMin(this->firstRoot);
+    this->numItems += 1;
+}
+
+/**
+ * @brief Removes an element with the smallest corrupted key.
+ *
+ * @param key Set to the original key of the removed element.
+ * @param id Set to the id of the removed element.
+ * @return bool True if an element was removed, false if the heap was empty.
+ */
+bool SoftHeap::extractMin(long long& key, int& id) {
+    if (this->firstRoot == -1) {
+        return false;
+    }
+
+    int x = this->nodes[this->firstRoot].suffixMin;
+    SoftNode& node = this->nodes[x];
+    int item = node.first;
+    node.first = this->items[item].next;
+    if (node.first == -1) {
+        node.last = -1;
+    }
+    node.count -= 1;
+    key = this->items[item].key;
+    id = this->items[item].id;
+    this->freeItems.push_back(item);
+    this->numItems -= 1;
+
+    if (node.count * 2 <= node.size) {
+        if (!this->isLeaf(x)) {
+            this->sift(x);
+            this->updateSuffixMin(x);
+        }
+        else if (node.count == 0) {
+            // Unlink the empty leaf from the root list.
+            int previous = -1;
+            for (int root = this->firstRoot; root != x; root = this->nodes[root].next) {
+                previous = root;
+            }
+            if (previous == -1) {
+                this->firstRoot = node.next;
+            }
+            else {
+                this->nodes[previous].next = node.next;
+                this->updateSuffixMin(previous);
+            }
+            this->freeNodes.push_back(x);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if the heap is empty.
+ *
+ * @return True if the heap is empty, false otherwise.
+ */
+bool SoftHeap::isEmpty() const {
+    return this->numItems == 0;
+}
+
+/**
+ * @brief Returns the number of elements in the heap.
+ *
+ * @return long long The number of elements in the heap.
+ */
+long long SoftHeap::getSize() const {
+    return this->numItems;
+}
+
+/**
+ * @brief Returns the error rate the heap was built with.
+ *
+ * @return double The fraction of insertions that may be corrupted.
+ */
+double SoftHeap::getErrorRate() const {
+    return this->errorRate;
+}
+
+/**
+ * @brief Returns the rank up to which nodes hold a single item.
+ *
+ * @return int The rank threshold ceil(log2(3 / errorRate)).
+ */
+int SoftHeap::getRankThreshold() const {
+    return this->rankThreshold;
+}
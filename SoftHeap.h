@@ -0,0 +1,153 @@
+#pragma once
+#include <vector>
+
+/**
+ * @class SoftHeap
+ * @brief A soft heap: a priority queue that may raise the keys of some elements
+ * in exchange for speed.
+ *
+ * This follows the simplified soft heap of Kaplan, Tarjan and Zwick. Elements
+ * live in item lists attached to the nodes of binary trees; every node has a
+ * key that is an upper bound of the keys in its list. Below the rank threshold
+ * T = ceil(log2(3 / errorRate)) a node holds one item, above it the lists grow
+ * by half per rank, and items sharing a list all report the list's key. Such
+ * items are called corrupted. At any time at most errorRate times the number of
+ * insertions are corrupted, and in return insert takes amortized O(1) and
+ * extractMin amortized O(log(1 / errorRate)) time.
+ *
+ * extractMin returns an item whose corrupted key is the smallest, together with
+ * its original key, so the returned keys are not necessarily in order.
+ */
+class SoftHeap
+{
+private:
+    /**
+     * @brief One element of the heap.
+     */
+    struct Item {
+        long long key;   ///< The original key
+        int id;          ///< Caller supplied identifier carried with the key
+        int next;        ///< Next item of the same list, -1 at the end
+    };
+
+    /**
+     * @brief A tree node with its item list.
+     */
+    struct SoftNode {
+        long long key;   ///< Corrupted key, an upper bound of the keys in the list
+        int left;        ///< Left child, -1 if none
+        int right;       ///< Right child, -1 if none
+        int next;        ///< Next root of higher rank, for roots only
+        int suffixMin;   ///< Root with the smallest key among this one and the ones after it
+        int first;       ///< First item of the list, -1 if empty
+        int last;        ///< Last item of the list, -1 if empty
+        int count;       ///< Number of items in the list
+        int size;        ///< Number of items the list is filled up to
+        int rank;        ///< Rank of the node, 0 for a leaf made by insert
+    };
+
+    std::vector<Item> items;       ///< Item storage
+    std::vector<SoftNode> nodes;   ///< Node storage
+    std::vector<int> freeItems;    ///< Released item slots
+    std::vector<int> freeNodes;    ///< Released node slots
+    int firstRoot;                 ///< Root of smallest rank, -1 if the heap is empty
+    int rankThreshold;             ///< Ranks up to this one hold a single item
+    double errorRate;              ///< Fraction of insertions that may be corrupted
+    long long numItems;            ///< Number of items in the heap
+
+    /**
+     * @brief Takes a node slot and initializes it with an empty list.
+     *
+     * @param rank The rank of the node.
+     * @param size The number of items the list is filled up to.
+     * @return int The node.
+     */
+    int newNode(int rank, int size);
+
+    /**
+     * @brief Checks whether a node has no children.
+     *
+     * @param x The node.
+     * @return bool True if the node is a leaf.
+     */
+    bool isLeaf(int x) const;
+
+    /**
+     * @brief Refills the list of a node from its children.
+     *
+     * The child with the smaller key gives its list to the node, which takes the
+     * child's key; the child is refilled in turn or removed once it is an empty leaf.
+     *
+     * @param x The node.
+     */
+    void sift(int x);
+
+    /**
+     * @brief Makes a new node of the next rank with two roots of equal rank as children.
+     *
+     * @param x The first root.
+     * @param y The second root.
+     * @return int The new node.
+     */
+    int link(int x, int y);
+
+    /**
+     * @brief Recomputes the suffix minimum of a root and of every root before it.
+     *
+     * @param x The last root whose suffix minimum may have changed.
+     */
+    void updateSuffixMin(int x);
+
+public:
+    /**
+     * @brief Constructs an empty soft heap.
+     *
+     * @param rate The fraction of insertions that may be corrupted, between 0 and 1.
+     */
+    SoftHeap(double rate = 1.0 / 3.0);
+
+    /**
+     * @brief Inserts an element.
+     *
+     * @param key The key of the element.
+     * @param id Optional identifier carried with the key (-1 if unused).
+     */
+    void insert(long long key, int id = -1);
+
+    /**
+     * @brief Removes an element with the smallest corrupted key.
+     *
+     * @param key Set to the original key of the removed element.
+     * @param id Set to the id of the removed element.
+     * @return bool True if an element was removed, false if the heap was empty.
+     */
+    bool extractMin(long long& key, int& id);
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return True if the heap is empty, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the number of elements in the heap.
+     *
+     * @return long long The number of elements in the heap.
+     */
+    long long getSize() const;
+
+    /**
+     * @brief Returns the error rate the heap was built with.
+     *
+     * @return double The fraction of insertions that may be corrupted.
+     */
+    double getErrorRate() const;
+
+    /**
+     * @brief Returns the rank up to which nodes hold a single item.
+     *
+     * @return int The rank threshold ceil(log2(3 / errorRate)).
+     */
+    int getRankThreshold() const;
+};
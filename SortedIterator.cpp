@@ -0,0 +1,67 @@
+#include "SortedIterator.h"
+#include <algorithm>
+
+/**
+ * @brief Orders the frontier so that the smallest key is at the front.
+ *
+ * @param a The first node.
+ * @param b The second node.
+ * @return True if a should come after b.
+ */
+static bool greaterKey(const Node* a, const Node* b) {
+    return a->getKey() > b->getKey();
+}
+
+/**
+ * @brief Constructs an iterator positioned at the minimum of the heap.
+ *
+ * @param heap The heap to be walked.
+ */
+SortedIterator::SortedIterator(const FibonacciHeap* heap) {
+    const Node* start = heap->getMinNode();
+    if (start == nullptr) {
+        return;
+    }
+
+    const Node* current = start;
+    do {
+        this->frontier.push_back(current);
+        current = current->getRight();
+    } while (current != start);
+    std::make_heap(this->frontier.begin(), this->frontier.end(), greaterKey);
+}
+
+/**
+ * @brief Checks if there are nodes left to visit.
+ *
+ * @return True if next can be called, false otherwise.
+ */
+bool SortedIterator::hasNext() const {
+    return !this->frontier.empty();
+}
+
+/**
+ * @brief Returns the next node in increasing key order.
+ *
+ * @return const Node* The next node, or nullptr if all nodes were visited.
+ */
+const Node* SortedIterator::next() {
+    if (this->frontier.empty()) {
+        return nullptr;
+    }
+
+    std::pop_heap(this->frontier.begin(), this->frontier.end(), greaterKey);
+    const Node* node = this->frontier.back();
+    this->frontier.pop_back();
+
+    const Node* child = node->getChild();
+    if (child != nullptr) {
+        const Node* current = child;
+        do {
+            this->frontier.push_back(current);
+            std::push_heap(this->frontier.begin(), this->frontier.end(), greaterKey);
+            current = current->getRight();
+        } while (current != child);
+    }
+    return node;
+}
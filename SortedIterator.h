@@ -0,0 +1,44 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <vector>
+
+/**
+ * @class SortedIterator
+ * @brief Walks the nodes of a Fibonacci Heap in increasing key order without
+ * modifying it.
+ *
+ * The iterator does a best-first walk of the heap-ordered forest. It keeps a
+ * small binary heap of frontier nodes, starting with the roots; every time the
+ * smallest frontier node is returned its children replace it. Returning the
+ * first k nodes costs O(r + k D log(r + k D)), where r is the number of roots
+ * and D the largest degree, and the heap itself is left unchanged.
+ *
+ * The heap must not be modified while an iterator over it is in use.
+ */
+class SortedIterator
+{
+private:
+    std::vector<const Node*> frontier; ///< Binary min-heap of nodes that may come next
+
+public:
+    /**
+     * @brief Constructs an iterator positioned at the minimum of the heap.
+     *
+     * @param heap The heap to be walked.
+     */
+    SortedIterator(const FibonacciHeap* heap);
+
+    /**
+     * @brief Checks if there are nodes left to visit.
+     *
+     * @return True if next can be called, false otherwise.
+     */
+    bool hasNext() const;
+
+    /**
+     * @brief Returns the next node in increasing key order.
+     *
+     * @return const Node* The next node, or nullptr if all nodes were visited.
+     */
+    const Node* next();
+};
@@ -0,0 +1,360 @@
+#include "SplitFibonacciHeap.h"
+#include "KeySearch.h"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief Constructs an empty heap.
+ *
+ * @param capacity The number of ids to reserve room for. Larger ids grow the arrays.
+ */
+SplitFibonacciHeap::SplitFibonacciHeap(int capacity) : minSlot(-1), numNodes(0) {
+    if (capacity > 0) {
+        this->reserveSlot(capacity - 1);
+    }
+}
+
+/**
+ * @brief Grows the arrays until a slot exists.
+ *
+ * @param slot The slot that must exist.
+ */
+void SplitFibonacciHeap::reserveSlot(int slot) {
+    if (size_t(slot) < this->keys.size()) {
+        return;
+    }
+    // Links hold slot indices, not pointers, so the arrays may move.
+    size_t size = std::max(size_t(slot) + 1, this->keys.size() * 2);
+    this->keys.resize(size, 0);
+    this->links.resize(size);
+    this->present.resize(size, false);
+}
+
+/**
+ * @brief Adds a slot to the root list as a single node tree.
+ *
+ * The children of the slot stay with it.
+ *
+ * @param x The slot.
+ */
+void SplitFibonacciHeap::addRoot(int x) {
+    Links& node = this->links[x];
+    node.parent = -1;
+    if (this->minSlot == -1) {
+        node.left = x;
+        node.right = x;
+        this->minSlot = x;
+        return;
+    }
+
+    Links& minimum = this->links[this->minSlot];
+    node.left = this->minSlot;
+    node.right = minimum.right;
+    this->links[minimum.right].left = x;
+    minimum.right = x;
+    if (this->keys[x] < this->keys[this->minSlot]) {
+        this->minSlot = x;
+    }
+}
+
+/**
+ * @brief Removes a slot from its sibling ring.
+ *
+ * @param x The slot.
+ */
+void SplitFibonacciHeap::unlinkSibling(int x) {
+    Links& node = this->links[x];
+    this->links[node.left].right = node.right;
+    this->links[node.right].left = node.left;
+}
+
+/**
+ * @brief Restructures the roots so that there is one tree of each degree.
+ */
+void SplitFibonacciHeap::consolidate() {
+    int degreeTable[maxDegree];
+    std::fill(degreeTable, degreeTable + maxDegree, -1);
+    int highest = 0;
+
+    // Linking only touches child rings; the root ring is rebuilt from the
+    // degree table afterwards, so the walk only needs the next root saved.
+    int start = this->minSlot;
+    int current = start;
+    do {
+        int x = current;
+        int next = this->links[current].right;
+        int d = this->links[x].degree;
+        while (degreeTable[d] != -1) {
+            int y = degreeTable[d];
+            if (this->keys[y] < this->keys[x]) {
+                std::swap(x, y);
+            }
+
+            Links& parent = this->links[x];
+            Links& child = this->links[y];
+            child.parent = x;
+            child.marked = false;
+            if (parent.child == -1) {
+                parent.child = y;
+                child.left = y;
+                child.right = y;
+            }
+            else {
+                Links& first = this->links[parent.child];
+                child.left = parent.child;
+                child.right = first.right;
+                this->links[first.right].left = y;
+                first.right = y;
+            }
+            parent.degree += 1;
+
+            degreeTable[d] = -1;
+            d += 1;
+        }
+        degreeTable[d] = x;
+        highest = std::max(highest, d);
+        current = next;
+    } while (current != start);
+
+    // Gather the keys of the roots into a packed buffer and pick the minimum
+    // with one vectorized scan instead of comparing the roots one by one.
+    long long rootKeys[maxDegree];
+    int rootSlots[maxDegree];
+    int count = 0;
+    for (int d = 0; d <= highest; d++) {
+        if (degreeTable[d] != -1) {
+            rootSlots[count] = degreeTable[d];
+            rootKeys[count] = this->keys[degreeTable[d]];
+            count += 1;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        Links& root = this->links[rootSlots[i]];
+        root.left = rootSlots[(i + count - 1) % count];
+        root.right = rootSlots[(i + 1) % count];
+    }
+    this->minSlot = rootSlots[KeySearch::minIndex(rootKeys, count)];
+}
+
+/**
+ * @brief Cuts slot x from its parent y and adds it to the root list.
+ *
+ * @param x The slot to be cut.
+ * @param y The parent of x.
+ */
+void SplitFibonacciHeap::cut(int x, int y) {
+    Links& parent = this->links[y];
+    if (parent.child == x) {
+        parent.child = this->links[x].right == x ? -1 : this->links[x].right;
+    }
+    this->unlinkSibling(x);
+    parent.degree -= 1;
+    this->links[x].marked = false;
+    this->addRoot(x);
+}
+
+/**
+ * @brief Performs a cascading cut starting at slot y.
+ *
+ * @param y The slot on which to perform the cascading cut.
+ */
+void SplitFibonacciHeap::cascadingCut(int y) {
+    while (this->links[y].parent != -1) {
+        int z = this->links[y].parent;
+        if (!this->links[y].marked) {
+            this->links[y].marked = true;
+            return;
+        }
+        this->cut(y, z);
+        y = z;
+    }
+}
+
+/**
+ * @brief Removes the minimum slot and restructures the heap.
+ */
+void SplitFibonacciHeap::removeMin() {
+    int z = this->minSlot;
+    int child = this->links[z].child;
+    if (child != -1) {
+        // Clear the parents, then splice the whole child ring into the root ring.
+        int x = child;
+        do {
+            this->links[x].parent = -1;
+            this->links[x].marked = false;
+            x = this->links[x].right;
+        } while (x != child);
+
+        int last = this->links[child].left;
+        int after = this->links[z].right;
+        this->links[z].right = child;
+        this->links[child].left = z;
+        this->links[last].right = after;
+        this->links[after].left = last;
+        this->links[z].child = -1;
+        this->links[z].degree = 0;
+    }
+
+    if (this->links[z].right == z) {
+        this->minSlot = -1;
+    }
+    else {
+        this->minSlot = this->links[z].right;
+        this->unlinkSibling(z);
+        this->consolidate();
+    }
+    this->present[z] = false;
+    this->numNodes -= 1;
+}
+
+/**
+ * @brief Inserts an id or changes its key.
+ *
+ * @param id The id of the element.
+ * @param key The new key of the element.
+ */
+void SplitFibonacciHeap::upsert(int id, long long key) {
+    if (id < 0) {
+        std::cout << "Upserting failed, because the id is negative.\n";
+        return;
+    }
+    this->reserveSlot(id);
+
+    if (!this->present[id]) {
+        this->keys[id] = key;
+        this->links[id] = Links{ -1, -1, id, id, 0, false };
+        this->addRoot(id);
+        this->present[id] = true;
+        this->numNodes += 1;
+        return;
+    }
+
+    long long current = this->keys[id];
+    int parent = this->links[id].parent;
+    if (key < current) {
+        this->keys[id] = key;
+        if (parent != -1 && key < this->keys[parent]) {
+            this->cut(id, parent);
+            this->cascadingCut(parent);
+        }
+        if (key < this->keys[this->minSlot]) {
+            this->minSlot = id;
+        }
+    }
+    else if (key > current) {
+        if (parent != -1) {
+            this->cut(id, parent);
+            this->cascadingCut(parent);
+        }
+
+        // The children may now be smaller than the slot, so they become roots.
+        int child = this->links[id].child;
+        while (child != -1) {
+            int next = this->links[child].right == child ? -1 : this->links[child].right;
+            this->unlinkSibling(child);
+            this->links[child].marked = false;
+            this->addRoot(child);
+            child = next;
+        }
+        this->links[id].child = -1;
+        this->links[id].degree = 0;
+        this->links[id].marked = false;
+
+        this->keys[id] = key;
+        if (this->minSlot == id) {
+            this->consolidate();
+        }
+    }
+}
+
+/**
+ * @brief Checks if an id is in the heap.
+ *
+ * @param id The id to look for.
+ * @return True if the id is in the heap, false otherwise.
+ */
+bool SplitFibonacciHeap::contains(int id) const {
+    return id >= 0 && size_t(id) < this->present.size() && this->present[id];
+}
+
+/**
+ * @brief Removes an id from the heap. Absent ids are ignored.
+ *
+ * @param id The id to be removed.
+ */
+void SplitFibonacciHeap::erase(int id) {
+    if (!this->contains(id)) {
+        return;
+    }
+    int parent = this->links[id].parent;
+    if (parent != -1) {
+        this->cut(id, parent);
+        this->cascadingCut(parent);
+    }
+    this->minSlot = id;
+    this->removeMin();
+}
+
+/**
+ * @brief Returns the key of an id.
+ *
+ * @param id The id.
+ * @param key Set to the key of the id if it is in the heap.
+ * @return bool True if the id is in the heap, false otherwise.
+ */
+bool SplitFibonacciHeap::keyOf(int id, long long& key) const {
+    if (!this->contains(id)) {
+        return false;
+    }
+    key = this->keys[id];
+    return true;
+}
+
+/**
+ * @brief Removes the element with the minimum key.
+ *
+ * @return int The id of the removed element, -1 if the heap was empty.
+ */
+int SplitFibonacciHeap::extractMin() {
+    int id = this->minSlot;
+    if (id != -1) {
+        this->removeMin();
+    }
+    return id;
+}
+
+/**
+ * @brief Returns the id of the element with the minimum key.
+ *
+ * @return int The id of the minimum element, -1 if the heap is empty.
+ */
+int SplitFibonacciHeap::getMinId() const {
+    return this->minSlot;
+}
+
+/**
+ * @brief Returns the minimum key in the heap.
+ *
+ * @return long long The minimum key, 0 if the heap is empty.
+ */
+long long SplitFibonacciHeap::getMinValue() const {
+    return this->minSlot == -1 ? 0 : this->keys[this->minSlot];
+}
+
+/**
+ * @brief Checks if the heap is empty.
+ *
+ * @return True if the heap is empty, false otherwise.
+ */
+bool SplitFibonacciHeap::isEmpty() const {
+    return this->minSlot == -1;
+}
+
+/**
+ * @brief Returns the number of ids in the heap.
+ *
+ * @return long long The number of ids in the heap.
+ */
+long long SplitFibonacciHeap::getSize() const {
+    return this->numNodes;
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SplitFibonacciHeap
+ * @brief A Fibonacci Heap addressed by dense integer ids, with keys and links stored apart.
+ *
+ * The interface matches IndexedFibonacciHeap, but instead of one 48-byte Node
+ * per id the heap keeps two arrays indexed by id: the keys, which every
+ * comparison reads, packed eight to a cache line, and the links (parent,
+ * child, siblings, degree and mark) as 32-bit slot indices in a separate
+ * array. After consolidation the keys of the remaining roots are gathered
+ * into a packed buffer and the new minimum is found with KeySearch::minIndex,
+ * which uses AVX2 or SSE4.2 when the processor has them.
+ */
+class SplitFibonacciHeap
+{
+private:
+    /**
+     * @brief The link fields of one slot, kept apart from its key.
+     */
+    struct Links {
+        int parent;       ///< Parent slot, -1 for a root
+        int child;        ///< Any child slot, -1 if none
+        int left;         ///< Left sibling slot
+        int right;        ///< Right sibling slot
+        uint8_t degree;   ///< Number of children
+        bool marked;      ///< Whether the slot lost a child since it became a child itself
+    };
+
+    static const int maxDegree = 64; ///< Degrees stay below 1.4405 * log2(2^31) < 45
+
+    std::vector<long long> keys;   ///< Key of every slot
+    std::vector<Links> links;      ///< Links of every slot
+    std::vector<bool> present;     ///< Whether each slot is in the heap
+    int minSlot;                   ///< Slot with the minimum key, -1 if the heap is empty
+    long long numNodes;            ///< Number of slots in the heap
+
+    /**
+     * @brief Grows the arrays until a slot exists.
+     *
+     * @param slot The slot that must exist.
+     */
+    void reserveSlot(int slot);
+
+    /**
+     * @brief Adds a slot to the root list as a single node tree.
+     *
+     * @param x The slot.
+     */
+    void addRoot(int x);
+
+    /**
+     * @brief Removes a slot from its sibling ring.
+     *
+     * @param x The slot.
+     */
+    void unlinkSibling(int x);
+
+    /**
+     * @brief Restructures the roots so that there is one tree of each degree.
+     */
+    void consolidate();
+
+    /**
+     * @brief Cuts slot x from its parent y and adds it to the root list.
+     *
+     * @param x The slot to be cut.
+     * @param y The parent of x.
+     */
+    void cut(int x, int y);
+
+    /**
+     * @brief Performs a cascading cut starting at slot y.
+     *
+     * @param y The slot on which to perform the cascading cut.
+     */
+    void cascadingCut(int y);
+
+    /**
+     * @brief Removes the minimum slot and restructures the heap.
+     */
+    void removeMin();
+
+public:
+    /**
+     * @brief Constructs an empty heap.
+     *
+     * @param capacity The number of ids to reserve room for. Larger ids grow the arrays.
+     */
+    SplitFibonacciHeap(int capacity = 0);
+
+    /**
+     * @brief Inserts an id or changes its key.
+     *
+     * An absent id is inserted. A smaller key is applied with a decrease key
+     * and a larger one with an increase key, both in place.
+     *
+     * @param id The id of the element.
+     * @param key The new key of the element.
+     */
+    void upsert(int id, long long key);
+
+    /**
+     * @brief Checks if an id is in the heap.
+     *
+     * @param id The id to look for.
+     * @return True if the id is in the heap, false otherwise.
+     */
+    bool contains(int id) const;
+
+    /**
+     * @brief Removes an id from the heap. Absent ids are ignored.
+     *
+     * @param id The id to be removed.
+     */
+    void erase(int id);
+
+    /**
+     * @brief Returns the key of an id.
+     *
+     * @param id The id.
+     * @param key Set to the key of the id if it is in the heap.
+     * @return bool True if the id is in the heap, false otherwise.
+     */
+    bool keyOf(int id, long long& key) const;
+
+    /**
+     * @brief Removes the element with the minimum key.
+     *
+     * @return int The id of the removed element, -1 if the heap was empty.
+     */
+    int extractMin();
+
+    /**
+     * @brief Returns the id of the element with the minimum key.
+     *
+     * @return int The id of the minimum element, -1 if the heap is empty.
+     */
+    int getMinId() const;
+
+    /**
+     * @brief Returns the minimum key in the heap.
+     *
+     * @return long long The minimum key, 0 if the heap is empty.
+     */
+    long long getMinValue() const;
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return True if the heap is empty, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the number of ids in the heap.
+     *
+     * @return long long The number of ids in the heap.
+     */
+    long long getSize() const;
+};
@@ -0,0 +1,290 @@
+#include "TaskExecutor.h"
+#include <algorithm>
+#include <iostream>
+
+static const uint64_t taskPending = 0;
+static const uint64_t taskRunning = 1;
+static const uint64_t taskCancelled = 2;
+static const uint64_t taskStateMask = 3;
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param workerCount The number of workers, at least one.
+ * @param batch The maximum number of tasks moved by one steal.
+ */
+TaskExecutor::TaskExecutor(int workerCount, int batch)
+    : stealBatch(std::max(batch, 1)), nextWorker(0),
+    chunks(new std::atomic<Task*>[maxChunks]), slotCount(0),
+    queued(0), outstanding(0), sleepers(0), stopping(false) {
+    for (int c = 0; c < maxChunks; c++) {
+        this->chunks[c].store(nullptr, std::memory_order_relaxed);
+    }
+
+    int count = std::max(workerCount, 1);
+    for (int i = 0; i < count; i++) {
+        Worker* worker = new Worker();
+        worker->heap = new FibonacciHeap();
+        this->workers.push_back(worker);
+    }
+    for (int i = 0; i < count; i++) {
+        this->workers[i]->thread = std::thread(&TaskExecutor::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Runs every task that is still pending, then stops the workers.
+ */
+TaskExecutor::~TaskExecutor() {
+    this->stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(this->idleMutex);
+        this->idleCondition.notify_all();
+    }
+
+    for (Worker* worker : this->workers) {
+        worker->thread.join();
+    }
+    for (Worker* worker : this->workers) {
+        delete worker->heap;
+        delete worker;
+    }
+    for (int c = 0; c < maxChunks; c++) {
+        delete[] this->chunks[c].load(std::memory_order_relaxed);
+    }
+    delete[] this->chunks;
+}
+
+/**
+ * @brief Returns the task stored in a slot.
+ *
+ * @param slot The slot of the task.
+ * @return Task& The task.
+ */
+TaskExecutor::Task& TaskExecutor::taskAt(int slot) const {
+    Task* chunk = this->chunks[slot >> chunkBits].load(std::memory_order_acquire);
+    return chunk[slot & ((1 << chunkBits) - 1)];
+}
+
+/**
+ * @brief Takes a free task slot, allocating a new chunk if needed.
+ *
+ * @return int The slot, or -1 if the executor holds the maximum number of tasks.
+ */
+int TaskExecutor::allocateSlot() {
+    std::lock_guard<std::mutex> lock(this->slotMutex);
+    if (!this->freeSlots.empty()) {
+        int slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+        return slot;
+    }
+
+    if (this->slotCount == maxChunks << chunkBits) {
+        return -1;
+    }
+
+    int slot = this->slotCount;
+    if ((slot & ((1 << chunkBits) - 1)) == 0) {
+        Task* chunk = new Task[1 << chunkBits];
+        for (int i = 0; i < (1 << chunkBits); i++) {
+            chunk[i].state.store(0, std::memory_order_relaxed);
+        }
+        this->chunks[slot >> chunkBits].store(chunk, std::memory_order_release);
+    }
+    this->slotCount += 1;
+    return slot;
+}
+
+/**
+ * @brief Returns a task slot once its task finished or was skipped.
+ *
+ * @param slot The slot to be released.
+ */
+void TaskExecutor::releaseSlot(int slot) {
+    std::lock_guard<std::mutex> lock(this->slotMutex);
+    this->freeSlots.push_back(slot);
+}
+
+/**
+ * @brief Submits a task.
+ *
+ * @param priority The priority of the task; smaller values run first.
+ * @param function The work to be done.
+ * @return TaskHandle A handle that can be passed to cancel.
+ */
+TaskHandle TaskExecutor::submit(int priority, std::function<void()> function) {
+    int slot = this->allocateSlot();
+    if (slot == -1) {
+        std::cout << "Submitting the task failed, because the executor is full.\n";
+        return TaskHandle{ -1, 0 };
+    }
+
+    Task& task = this->taskAt(slot);
+    task.function = std::move(function);
+    uint64_t generation = (task.state.load(std::memory_order_relaxed) >> 2) + 1;
+    task.state.store((generation << 2) | taskPending, std::memory_order_release);
+    this->outstanding.fetch_add(1);
+
+    Worker* worker = this->workers[this->nextWorker.fetch_add(1, std::memory_order_relaxed) % this->workers.size()];
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->heap->insert(priority, slot);
+    }
+
+    this->queued.fetch_add(1);
+    if (this->sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(this->idleMutex);
+        this->idleCondition.notify_one();
+    }
+    return TaskHandle{ slot, uint32_t(generation) };
+}
+
+/**
+ * @brief Cancels a task that has not started yet.
+ *
+ * @param handle The handle returned by submit.
+ * @return bool True if the task will not run, false otherwise.
+ */
+bool TaskExecutor::cancel(TaskHandle handle) {
+    if (handle.slot < 0 || handle.slot >= (maxChunks << chunkBits)
+        || this->chunks[handle.slot >> chunkBits].load(std::memory_order_acquire) == nullptr) {
+        return false;
+    }
+
+    Task& task = this->taskAt(handle.slot);
+    uint64_t state = task.state.load();
+    if (uint32_t(state >> 2) != handle.generation || (state & taskStateMask) != taskPending) {
+        return false;
+    }
+    return task.state.compare_exchange_strong(state, (state & ~taskStateMask) | taskCancelled);
+}
+
+/**
+ * @brief Blocks until every submitted task finished or was cancelled.
+ */
+void TaskExecutor::wait() {
+    std::unique_lock<std::mutex> lock(this->idleMutex);
+    this->doneCondition.wait(lock, [this]() { return this->outstanding.load() == 0; });
+}
+
+/**
+ * @brief Returns the number of worker threads.
+ *
+ * @return int The number of workers.
+ */
+int TaskExecutor::getWorkerCount() const {
+    return int(this->workers.size());
+}
+
+/**
+ * @brief Removes the most urgent task from a worker's own heap.
+ *
+ * @param worker The worker.
+ * @return int The slot of the task, -1 if the heap is empty.
+ */
+int TaskExecutor::popLocal(Worker* worker) {
+    Node* node;
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        node = worker->heap->extractMin();
+    }
+    if (node == nullptr) {
+        return -1;
+    }
+    int slot = node->getId();
+    delete node;
+    return slot;
+}
+
+/**
+ * @brief Moves a batch of the most urgent tasks of another worker into
+ * the heap of the given worker.
+ *
+ * @param index The index of the stealing worker.
+ * @return bool True if any task was stolen, false otherwise.
+ */
+bool TaskExecutor::steal(int index) {
+    int count = int(this->workers.size());
+    for (int k = 1; k < count; k++) {
+        Worker* victim = this->workers[(index + k) % count];
+        FibonacciHeap* batch = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(victim->mutex);
+            long long size = victim->heap->getSize();
+            if (size == 0) {
+                continue;
+            }
+
+            // Take at most half of the victim's tasks so that it keeps working.
+            int take = int(std::min<long long>(this->stealBatch, (size + 1) / 2));
+            batch = new FibonacciHeap();
+            for (int i = 0; i < take; i++) {
+                // The extracted node itself moves into the batch.
+                batch->insertNode(victim->heap->extractMin());
+            }
+        }
+
+        Worker* thief = this->workers[index];
+        std::lock_guard<std::mutex> lock(thief->mutex);
+        thief->heap->unionHeap(batch);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Runs a task unless it was cancelled, then releases its slot.
+ *
+ * @param slot The slot of the task.
+ */
+void TaskExecutor::runTask(int slot) {
+    Task& task = this->taskAt(slot);
+    uint64_t state = task.state.load();
+    if ((state & taskStateMask) == taskPending
+        && task.state.compare_exchange_strong(state, (state & ~taskStateMask) | taskRunning)) {
+        task.function();
+    }
+    task.function = nullptr;
+    this->releaseSlot(slot);
+
+    if (this->outstanding.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(this->idleMutex);
+        this->doneCondition.notify_all();
+    }
+}
+
+/**
+ * @brief The main loop of a worker thread.
+ *
+ * @param index The index of the worker.
+ */
+void TaskExecutor::workerLoop(int index) {
+    Worker* worker = this->workers[index];
+    while (true) {
+        int slot = this->popLocal(worker);
+        if (slot == -1 && this->steal(index)) {
+            slot = this->popLocal(worker);
+        }
+        if (slot != -1) {
+            this->queued.fetch_sub(1);
+            this->runTask(slot);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->idleMutex);
+        if (this->queued.load() > 0) {
+            // A task is between two heaps while another worker steals it.
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        if (this->stopping.load()) {
+            return;
+        }
+        this->sleepers.fetch_add(1);
+        if (this->queued.load() == 0 && !this->stopping.load()) {
+            this->idleCondition.wait(lock);
+        }
+        this->sleepers.fetch_sub(1);
+    }
+}
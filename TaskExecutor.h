@@ -0,0 +1,170 @@
+#pragma once
+#include "FibonacciHeap.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct TaskHandle
+ * @brief Identifies a submitted task so that it can be cancelled.
+ */
+struct TaskHandle {
+    int slot;              ///< Slot of the task in the executor
+    uint32_t generation;   ///< Generation of the slot when the task was submitted
+};
+
+/**
+ * @class TaskExecutor
+ * @brief Runs prioritized tasks on a pool of worker threads.
+ *
+ * Every worker owns a Fibonacci Heap of pending tasks keyed by priority, where
+ * a smaller key runs first. Submitted tasks are spread over the workers. A
+ * worker whose heap is empty steals a batch of the most urgent tasks of
+ * another worker and melds them into its own heap with unionHeap, which splices
+ * the root rings in constant time.
+ */
+class TaskExecutor
+{
+private:
+    /**
+     * @brief A submitted task and its state.
+     *
+     * The state packs the generation of the slot with Pending, Running or
+     * Cancelled, so a stale handle can never cancel a newer task.
+     */
+    struct Task {
+        std::function<void()> function;  ///< The work to be done
+        std::atomic<uint64_t> state;     ///< (generation << 2) | state
+    };
+
+    /**
+     * @brief A worker thread and its local heap of pending tasks.
+     */
+    struct Worker {
+        std::mutex mutex;        ///< Guards heap
+        FibonacciHeap* heap;     ///< Pending tasks, keyed by priority, id is the task slot
+        std::thread thread;      ///< The thread running workerLoop
+    };
+
+    static const int chunkBits = 10;         ///< log2 of the number of tasks in a chunk
+    static const int maxChunks = 1 << 16;    ///< Maximum number of task chunks
+
+    std::vector<Worker*> workers;            ///< The worker pool
+    int stealBatch;                          ///< Maximum number of tasks taken in one steal
+    std::atomic<unsigned> nextWorker;        ///< Round robin position for submit
+
+    std::atomic<Task*>* chunks;              ///< Task storage, allocated one chunk at a time
+    std::mutex slotMutex;                    ///< Guards freeSlots and chunk allocation
+    std::vector<int> freeSlots;              ///< Released task slots
+    int slotCount;                           ///< Number of slots ever handed out
+
+    std::atomic<long> queued;                ///< Tasks sitting in a worker heap
+    std::atomic<long> outstanding;           ///< Tasks submitted but not yet finished
+    std::atomic<int> sleepers;               ///< Workers waiting for new tasks
+    std::atomic<bool> stopping;              ///< Set by the destructor
+    std::mutex idleMutex;                    ///< Guards idleCondition and doneCondition
+    std::condition_variable idleCondition;   ///< Wakes sleeping workers
+    std::condition_variable doneCondition;   ///< Wakes callers of wait
+
+    /**
+     * @brief Returns the task stored in a slot.
+     *
+     * @param slot The slot of the task.
+     * @return Task& The task.
+     */
+    Task& taskAt(int slot) const;
+
+    /**
+     * @brief Takes a free task slot, allocating a new chunk if needed.
+     *
+     * @return int The slot, or -1 if the executor holds the maximum number of tasks.
+     */
+    int allocateSlot();
+
+    /**
+     * @brief Returns a task slot once its task finished or was skipped.
+     *
+     * @param slot The slot to be released.
+     */
+    void releaseSlot(int slot);
+
+    /**
+     * @brief Removes the most urgent task from a worker's own heap.
+     *
+     * @param worker The worker.
+     * @return int The slot of the task, -1 if the heap is empty.
+     */
+    int popLocal(Worker* worker);
+
+    /**
+     * @brief Moves a batch of the most urgent tasks of another worker into
+     * the heap of the given worker.
+     *
+     * @param index The index of the stealing worker.
+     * @return bool True if any task was stolen, false otherwise.
+     */
+    bool steal(int index);
+
+    /**
+     * @brief Runs a task unless it was cancelled, then releases its slot.
+     *
+     * @param slot The slot of the task.
+     */
+    void runTask(int slot);
+
+    /**
+     * @brief The main loop of a worker thread.
+     *
+     * @param index The index of the worker.
+     */
+    void workerLoop(int index);
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param workerCount The number of workers, at least one.
+     * @param batch The maximum number of tasks moved by one steal.
+     */
+    TaskExecutor(int workerCount, int batch = 16);
+
+    /**
+     * @brief Runs every task that is still pending, then stops the workers.
+     */
+    ~TaskExecutor();
+
+    /**
+     * @brief Submits a task.
+     *
+     * @param priority The priority of the task; smaller values run first.
+     * @param function The work to be done.
+     * @return TaskHandle A handle that can be passed to cancel. Its slot is -1
+     * if the executor is full and the task was not submitted.
+     */
+    TaskHandle submit(int priority, std::function<void()> function);
+
+    /**
+     * @brief Cancels a task that has not started yet.
+     *
+     * @param handle The handle returned by submit.
+     * @return bool True if the task will not run, false if it already started,
+     * finished or was cancelled before.
+     */
+    bool cancel(TaskHandle handle);
+
+    /**
+     * @brief Blocks until every submitted task finished or was cancelled.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads.
+     *
+     * @return int The number of workers.
+     */
+    int getWorkerCount() const;
+};
@@ -1,4 +1,5 @@
 #include "Utilities.h"
+#include "SortedIterator.h"
 #include <iostream>
 
 // Implementation of the printTree method
@@ -44,3 +45,13 @@ void Utilities::printHeap(FibonacciHeap* heap) const{
     }
     std::cout << "\n\n\n\n";
 }
+
+// Implementation of the peekSmallest method
+std::vector<long long> Utilities::peekSmallest(const FibonacciHeap* heap, int k) const {
+    std::vector<long long> keys;
+    SortedIterator iterator(heap);
+    while (int(keys.size()) < k && iterator.hasNext()) {
+        keys.push_back(iterator.next()->getKey());
+    }
+    return keys;
+}
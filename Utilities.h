@@ -1,5 +1,6 @@
 #pragma once
 #include "FibonacciHeap.h" 
+#include <vector>
 /**
  * @class Utilities
  * @brief Provides utilites function on the heap that do not alterate
@@ -10,6 +11,9 @@ public:
     // Public method to print the heap
     void printHeap(FibonacciHeap* heap) const;
 
+    // Public method returning the k smallest keys in increasing order
+    std::vector<long long> peekSmallest(const FibonacciHeap* heap, int k) const;
+
 private:
     // Private method to recursively print the tree
     void printTree(Node* node, int depth = 0) const;
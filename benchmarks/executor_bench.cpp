@@ -0,0 +1,58 @@
+#include "../TaskExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Submits tasks with random priorities and measures how many tasks per second
+// the executor runs and how often a task runs right after a more urgent one
+// was still waiting (adjacent priority inversions in execution order).
+static void run(int workers, int tasks, int work) {
+    std::vector<int> executed(tasks);
+    std::atomic<int> ticket(0);
+    std::vector<int> priorities(tasks);
+    std::mt19937 random(7);
+    for (int i = 0; i < tasks; i++) {
+        priorities[i] = int(random() % 1000000);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        TaskExecutor executor(workers);
+        for (int i = 0; i < tasks; i++) {
+            int priority = priorities[i];
+            executor.submit(priority, [&executed, &ticket, priority, work]() {
+                volatile int spin = 0;
+                for (int k = 0; k < work; k++) {
+                    spin = spin + k;
+                }
+                executed[ticket.fetch_add(1)] = priority;
+            });
+        }
+        executor.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long inversions = 0;
+    for (int i = 1; i < tasks; i++) {
+        if (executed[i] < executed[i - 1]) {
+            inversions += 1;
+        }
+    }
+    std::cout << workers << " workers: " << tasks / seconds / 1e6 << " M tasks/s, "
+        << 100.0 * inversions / (tasks - 1) << " % adjacent inversions" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int tasks = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int work = argc > 2 ? std::atoi(argv[2]) : 200;
+    int maxWorkers = std::max(1, int(std::thread::hardware_concurrency()));
+
+    for (int workers = 1; workers <= maxWorkers; workers *= 2) {
+        run(workers, tasks, work);
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "../Simulation.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// Classic hold model: the event list is filled with n events, then every
+// processed event schedules one new event at an exponentially distributed
+// delay, which keeps the size of the event list constant.
+static long long hold(int size, long long operations, unsigned seed) {
+    Simulation simulation;
+    std::mt19937 random(seed);
+    std::exponential_distribution<double> delay(1.0 / 1000.0);
+
+    simulation.setHandler(0, [&](Simulation& sim, const Event&) {
+        sim.schedule(sim.getTime() + (long long)delay(random), 0);
+    });
+    for (int i = 0; i < size; i++) {
+        simulation.schedule((long long)delay(random), 0);
+    }
+
+    for (long long i = 0; i < operations; i++) {
+        simulation.step();
+    }
+    return simulation.getTime();
+}
+
+int main(int argc, char** argv) {
+    long long operations = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    int replications = argc > 2 ? std::atoi(argv[2]) : 8;
+
+    for (int size = 1000; size <= 1000000; size *= 10) {
+        auto start = std::chrono::steady_clock::now();
+        hold(size, operations, 1);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "event list " << size << ": " << seconds * 1e9 / operations << " ns/hold" << std::endl;
+    }
+
+    int threads = int(std::thread::hardware_concurrency());
+    auto start = std::chrono::steady_clock::now();
+    Simulation::runReplications(replications, threads, [operations](int replication) {
+        return hold(10000, operations, unsigned(replication));
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << replications << " replications on " << threads << " threads: "
+        << seconds << " s" << std::endl;
+    return 0;
+}
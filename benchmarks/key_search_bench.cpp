@@ -0,0 +1,106 @@
+#include "../IndexedFibonacciHeap.h"
+#include "../KeySearch.h"
+#include "../SplitFibonacciHeap.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Times the minimum search over a packed array of count keys, scalar loop
+// against the vectorized search. Both loops change their own copy of the keys
+// in the same order, so they search the same data in every round.
+static void runSearch(int count, int rounds) {
+    std::mt19937_64 random(7);
+    std::vector<long long> scalarKeys(count);
+    for (long long& key : scalarKeys) {
+        key = (long long)(random() >> 1);
+    }
+    std::vector<long long> vectorKeys = scalarKeys;
+
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        scalarKeys[r % count] ^= 1;
+        checksum += KeySearch::minIndexScalar(scalarKeys.data(), count);
+    }
+    double scalar = secondsSince(start) * 1e9 / (double(rounds) * count);
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        vectorKeys[r % count] ^= 1;
+        checksum -= KeySearch::minIndex(vectorKeys.data(), count);
+    }
+    double vector = secondsSince(start) * 1e9 / (double(rounds) * count);
+
+    std::cout << "keys " << count << "  scalar: " << scalar << " ns/key  "
+        << KeySearch::getInstructionSet() << ": " << vector << " ns/key  speedup: " << scalar / vector
+        << (checksum == 0 ? "" : "  (results differ)") << std::endl;
+}
+
+// Fills a heap with n ids, consolidates it with one extractMin, then runs
+// rounds that each extract the minimum and decrease the keys of a few random
+// ids, like a shortest path search. Both heaps get the same operations, so
+// the checksum of the extracted ids must agree.
+template <typename Heap>
+static void runHeap(const char* name, int n, int rounds) {
+    std::mt19937_64 random(42);
+    std::vector<long long> keys(static_cast<size_t>(n));
+    Heap heap(n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int id = 0; id < n; id++) {
+        keys[id] = (long long)(random() >> 4);
+        heap.upsert(id, keys[id]);
+    }
+    double insertSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    long long checksum = heap.extractMin();
+    double firstSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds && !heap.isEmpty(); r++) {
+        checksum = checksum * 31 + heap.extractMin();
+        for (int i = 0; i < 4; i++) {
+            int id = int(random() % n);
+            if (heap.contains(id)) {
+                keys[id] -= (long long)(random() % 1000000);
+                heap.upsert(id, keys[id]);
+            }
+        }
+    }
+    double roundSeconds = secondsSince(start);
+
+    std::cout << name << "  insert: " << insertSeconds * 1e9 / n << " ns/op"
+        << "  first extractMin: " << firstSeconds * 1e3 << " ms"
+        << "  extractMin + 4 decreaseKey: " << roundSeconds * 1e9 / rounds << " ns/round"
+        << "  checksum " << checksum << std::endl;
+}
+
+int main(int argc, char** argv) {
+    // A heap built after another one was freed gets scattered memory and runs
+    // much slower, so compare the layouts in separate processes.
+    std::string mode = argc > 1 ? argv[1] : "search";
+    int n = argc > 2 ? std::atoi(argv[2]) : 8000000;
+    int rounds = argc > 3 ? std::atoi(argv[3]) : 1000000;
+
+    if (mode == "node") {
+        runHeap<IndexedFibonacciHeap>("Node layout (IndexedFibonacciHeap)", n, rounds);
+    }
+    else if (mode == "split") {
+        runHeap<SplitFibonacciHeap>("split layout (SplitFibonacciHeap)", n, rounds);
+    }
+    else {
+        std::cout << "Minimum search (" << KeySearch::getInstructionSet() << ")" << std::endl;
+        runSearch(32, 2000000);
+        runSearch(96, 1000000);
+        runSearch(4096, 20000);
+        runSearch(1 << 20, 100);
+    }
+    return 0;
+}
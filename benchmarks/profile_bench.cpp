@@ -0,0 +1,67 @@
+#include "../FibonacciHeap.h"
+#include "../HeapProfiler.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Mixed workload: every round inserts a batch of keys, decreases random keys,
+// deletes a few nodes, extracts some minima and melds in a small heap, so that
+// every operation and long cascading cut chains show up in the report.
+int main(int argc, char** argv) {
+#ifndef FIBHEAP_PROFILE
+    std::cout << "Build with -DFIBHEAP_PROFILE to record heap operations.\n";
+#endif
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int samplePeriod = argc > 2 ? std::atoi(argv[2]) : 0;
+    const char* jsonPath = argc > 3 ? argv[3] : "heap_profile.json";
+
+    HeapProfiler::instance().setCounterSampling(samplePeriod);
+    std::mt19937 random(7);
+    FibonacciHeap heap;
+    // The id of every node in handles is its position there, so that removing
+    // an extracted node takes constant time; melded nodes keep the id -1.
+    std::vector<Node*> handles;
+    auto dropHandle = [&handles](size_t at) {
+        handles[at] = handles.back();
+        handles[at]->setId(int(at));
+        handles.pop_back();
+    };
+
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < 200; i++) {
+            handles.push_back(heap.insert(int(random() % 1000000000), int(handles.size())));
+        }
+        for (int i = 0; i < 100 && !handles.empty(); i++) {
+            Node* node = handles[random() % handles.size()];
+            heap.decreaseKey(node, node->getKey() - int(random() % 1000000));
+        }
+        for (int i = 0; i < 10 && !handles.empty(); i++) {
+            size_t at = random() % handles.size();
+            heap.deleteNode(handles[at]);
+            dropHandle(at);
+        }
+
+        FibonacciHeap* other = new FibonacciHeap();
+        for (int i = 0; i < 20; i++) {
+            other->insert(int(random() % 1000000000));
+        }
+        heap.unionHeap(other);
+
+        // Extracted nodes are dropped from the handles to keep them valid.
+        for (int i = 0; i < 150; i++) {
+            Node* node = heap.extractMin();
+            if (node->getId() >= 0) {
+                dropHandle(size_t(node->getId()));
+            }
+            delete node;
+        }
+    }
+
+    std::cout << HeapProfiler::instance().toTable();
+    std::ofstream json(jsonPath);
+    json << HeapProfiler::instance().toJson();
+    std::cout << "JSON written to " << jsonPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "../FibonacciHeap.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+
+// Checks a heap with more elements than fit in an int: sizes, the first
+// minimum, decreaseKey on nodes deep in consolidated trees and the order of
+// the extracted keys. Keys use the full 62-bit range. The default of 3.2
+// billion elements needs about 200 GB of memory; counts up to INT_MAX only
+// check the same code paths below the 32-bit limit, which the output says.
+static long long keyOf(long long i) {
+    unsigned long long z = (unsigned long long)i + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (long long)((z ^ (z >> 31)) >> 2);
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    long long count = argc > 1 ? std::atoll(argv[1]) : 3200000000LL;
+    long long extracts = argc > 2 ? std::atoll(argv[2]) : 1000000;
+    const long long sampleEvery = 1 << 24;
+    bool passed = true;
+
+    // Every node is a separate allocation with the allocator's header.
+    const double bytesPerNode = double(sizeof(Node) + 16);
+    double neededGb = count * bytesPerNode / 1e9;
+    double physicalGb = double(sysconf(_SC_PHYS_PAGES)) * double(sysconf(_SC_PAGESIZE)) / 1e9;
+    if (neededGb > physicalGb) {
+        std::cout << "The scale test failed, because " << count << " nodes need about " << neededGb
+            << " GB and the machine has " << physicalGb << " GB. Pass a smaller count.\n";
+        return 1;
+    }
+    std::cout << count << " nodes, about " << neededGb << " GB, "
+        << (count > INT_MAX ? "beyond" : "within") << " the 32-bit limit" << std::endl;
+
+    FibonacciHeap* heap = new FibonacciHeap();
+    std::vector<Node*> samples;
+    long long smallest = LLONG_MAX;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < count; i++) {
+        long long key = keyOf(i);
+        Node* node = heap->insert(key);
+        smallest = key < smallest ? key : smallest;
+        if (i % sampleEvery == sampleEvery / 2) {
+            samples.push_back(node);
+        }
+    }
+    double seconds = secondsSince(start);
+    std::cout << "inserted " << heap->getSize() << " nodes: " << count / seconds / 1e6 << " M/s" << std::endl;
+    if (heap->getSize() != count) {
+        std::cout << "size check failed\n";
+        passed = false;
+    }
+
+    start = std::chrono::steady_clock::now();
+    Node* first = heap->extractMin();
+    std::cout << "first extractMin (consolidates everything): " << secondsSince(start) << " s" << std::endl;
+    if (first->getKey() != smallest || heap->getSize() != count - 1) {
+        std::cout << "first minimum check failed\n";
+        passed = false;
+    }
+
+    // Move the sampled nodes below every other key; they have to come out first.
+    long long decreased = 0;
+    for (Node* node : samples) {
+        if (node != first) {
+            heap->decreaseKey(node, -1 - decreased);
+            decreased += 1;
+        }
+    }
+    delete first;
+
+    start = std::chrono::steady_clock::now();
+    long long previous = LLONG_MIN;
+    long long done = 0;
+    for (; done < extracts && !heap->isEmpty(); done++) {
+        Node* node = heap->extractMin();
+        long long key = node->getKey();
+        if (key < previous || (done < decreased && key != done - decreased)) {
+            std::cout << "order check failed at extraction " << done << "\n";
+            passed = false;
+            delete node;
+            break;
+        }
+        previous = key;
+        delete node;
+    }
+    seconds = secondsSince(start);
+    std::cout << "extracted " << done << " minima: " << seconds * 1e9 / (done > 0 ? done : 1) << " ns/op" << std::endl;
+    if (passed && heap->getSize() != count - 1 - done) {
+        std::cout << "size check after extraction failed\n";
+        passed = false;
+    }
+
+    start = std::chrono::steady_clock::now();
+    delete heap;
+    std::cout << "destroyed: " << secondsSince(start) << " s" << std::endl;
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
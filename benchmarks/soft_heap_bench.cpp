@@ -0,0 +1,71 @@
+#include "../FibonacciHeap.h"
+#include "../Selection.h"
+#include "../SoftHeap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Finds the median of n random keys: exactly by extracting n / 2 minima from a
+// FibonacciHeap, approximately by extracting n / 2 elements from soft heaps of
+// decreasing error rate, and exactly with the soft heap based linear selection.
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    long long n = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    std::mt19937_64 random(5);
+    std::vector<long long> values(size_t(n), 0);
+    for (long long& value : values) {
+        value = (long long)(random() >> 2);
+    }
+    std::vector<long long> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    long long half = n / 2;
+
+    auto start = std::chrono::steady_clock::now();
+    FibonacciHeap* heap = new FibonacciHeap();
+    for (long long value : values) {
+        heap->insert(value);
+    }
+    long long median = 0;
+    for (long long i = 0; i < half; i++) {
+        Node* node = heap->extractMin();
+        median = node->getKey();
+        delete node;
+    }
+    delete heap;
+    double exactSeconds = secondsSince(start);
+    std::cout << "FibonacciHeap exact:   " << exactSeconds << " s" << std::endl;
+
+    for (double errorRate : { 0.5, 1.0 / 3.0, 0.1, 0.01, 0.001 }) {
+        start = std::chrono::steady_clock::now();
+        SoftHeap soft(errorRate);
+        for (long long value : values) {
+            soft.insert(value);
+        }
+        long long largest = 0;
+        for (long long i = 0; i < half; i++) {
+            long long key;
+            int id;
+            soft.extractMin(key, id);
+            largest = std::max(largest, key);
+        }
+        double seconds = secondsSince(start);
+        long long rank = std::lower_bound(sorted.begin(), sorted.end(), largest) - sorted.begin();
+        std::cout << "SoftHeap eps " << errorRate << ": " << seconds << " s, "
+            << exactSeconds / seconds << "x, rank error " << double(rank - (half - 1)) / double(n)
+            << " (T = " << soft.getRankThreshold() << ")" << std::endl;
+    }
+
+    Selection selection;
+    start = std::chrono::steady_clock::now();
+    long long selected = selection.select(values, half - 1);
+    double seconds = secondsSince(start);
+    std::cout << "Selection::select:     " << seconds << " s, " << exactSeconds / seconds << "x, "
+        << (selected == median ? "same median" : "WRONG median") << std::endl;
+    return 0;
+}
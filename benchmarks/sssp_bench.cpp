@@ -0,0 +1,52 @@
+#include "../ShortestPaths.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// Random directed graph with uniform weights in [1, 1000]: every vertex gets an
+// edge to the next one so that all vertices are reachable, plus random edges.
+static CsrGraph randomGraph(const ShortestPaths& paths, int vertexCount, int degree, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> vertex(0, vertexCount - 1);
+    std::uniform_int_distribution<int> weight(1, 1000);
+
+    std::vector<int> sources, targets, weights;
+    for (int v = 0; v < vertexCount; v++) {
+        sources.push_back(v);
+        targets.push_back((v + 1) % vertexCount);
+        weights.push_back(weight(random));
+        for (int d = 1; d < degree; d++) {
+            sources.push_back(v);
+            targets.push_back(vertex(random));
+            weights.push_back(weight(random));
+        }
+    }
+    return paths.buildGraph(vertexCount, sources, targets, weights);
+}
+
+int main(int argc, char** argv) {
+    int vertexCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int degree = argc > 2 ? std::atoi(argv[2]) : 8;
+    int threads = argc > 3 ? std::atoi(argv[3]) : int(std::thread::hardware_concurrency());
+
+    ShortestPaths paths;
+    CsrGraph graph = randomGraph(paths, vertexCount, degree, 1);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> expected = paths.dijkstra(graph, 0);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "dijkstra: " << seconds << " s" << std::endl;
+
+    for (int delta = 50; delta <= 3200; delta *= 4) {
+        for (int t = 1; t <= threads; t *= 2) {
+            start = std::chrono::steady_clock::now();
+            std::vector<int> distance = paths.deltaStepping(graph, 0, delta, t);
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "delta " << delta << ", " << t << " threads: " << seconds << " s"
+                << (distance == expected ? "" : " (wrong distances)") << std::endl;
+        }
+    }
+    return 0;
+}
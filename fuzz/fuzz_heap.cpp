@@ -0,0 +1,185 @@
+#include "../FibonacciHeap.h"
+#include "../HeapValidator.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Differential fuzzer: the input bytes are decoded into a sequence of heap
+// operations that run on a FibonacciHeap and on a std::multiset of (key, id)
+// pairs. After every operation the heap is validated and its minimum and size
+// are compared with the multiset.
+
+/**
+ * @brief Reads the fuzzer input byte by byte, returning 0 once it is used up.
+ */
+class InputReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+
+public:
+    InputReader(const uint8_t* bytes, size_t length) : data(bytes), size(length), position(0) {}
+
+    bool done() const {
+        return this->position >= this->size;
+    }
+
+    uint8_t byte() {
+        return this->done() ? 0 : this->data[this->position++];
+    }
+
+    long long key() {
+        // Small keys, so that duplicates and equal-key links are common.
+        return (long long)int8_t(this->byte()) * 3;
+    }
+};
+
+static void fail(const char* operation, const char* reason) {
+    std::cerr << "Mismatch after " << operation << ": " << reason << std::endl;
+    std::abort();
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    InputReader input(data, size);
+    FibonacciHeap heap;
+    std::multiset<std::pair<long long, int>> model;
+    std::vector<Node*> live;          // Handles of the nodes still in the heap
+    std::vector<size_t> where;        // Index in live of every id
+    int nextId = 0;
+    HeapValidator validator;
+
+    auto add = [&](Node* node) {
+        where.push_back(live.size());
+        live.push_back(node);
+        model.insert(std::make_pair(node->getKey(), node->getId()));
+    };
+    auto forget = [&](Node* node) {
+        size_t at = where[node->getId()];
+        live[at] = live.back();
+        where[live[at]->getId()] = at;
+        live.pop_back();
+        model.erase(model.find(std::make_pair(node->getKey(), node->getId())));
+    };
+
+    while (!input.done()) {
+        const char* operation = "";
+        switch (input.byte() % 7) {
+        case 0: {
+            operation = "insert";
+            add(heap.insert(input.key(), nextId++));
+            break;
+        }
+        case 1: {
+            operation = "extractMin";
+            Node* node = heap.extractMin();
+            if ((node == nullptr) != model.empty()) {
+                fail(operation, "emptiness differs");
+            }
+            if (node != nullptr) {
+                if (node->getKey() != model.begin()->first) {
+                    fail(operation, "extracted key is not the minimum");
+                }
+                forget(node);
+                delete node;
+            }
+            break;
+        }
+        case 2: {
+            operation = "decreaseKey";
+            if (live.empty()) {
+                break;
+            }
+            Node* node = live[input.byte() % live.size()];
+            long long newKey = node->getKey() - input.byte() % 16;
+            model.erase(model.find(std::make_pair(node->getKey(), node->getId())));
+            heap.decreaseKey(node, newKey);
+            model.insert(std::make_pair(newKey, node->getId()));
+            break;
+        }
+        case 3: {
+            operation = "deleteNode";
+            if (live.empty()) {
+                break;
+            }
+            Node* node = live[input.byte() % live.size()];
+            forget(node);
+            heap.deleteNode(node);
+            break;
+        }
+        case 4: {
+            operation = "unionHeap";
+            FibonacciHeap* other = new FibonacciHeap();
+            int count = input.byte() % 8;
+            for (int i = 0; i < count; i++) {
+                add(other->insert(input.key(), nextId++));
+            }
+            heap.unionHeap(other);
+            if (count == 0) {
+                // unionHeap only takes over, and deletes, a non-empty heap.
+                delete other;
+            }
+            break;
+        }
+        case 5: {
+            operation = "increaseKey";
+            if (live.empty()) {
+                break;
+            }
+            Node* node = live[input.byte() % live.size()];
+            long long newKey = node->getKey() + input.byte() % 16;
+            model.erase(model.find(std::make_pair(node->getKey(), node->getId())));
+            heap.increaseKey(node, newKey);
+            model.insert(std::make_pair(newKey, node->getId()));
+            break;
+        }
+        default: {
+            operation = "getMinValue";
+            if (!model.empty() && heap.getMinValue() != model.begin()->first) {
+                fail(operation, "minimum differs");
+            }
+            break;
+        }
+        }
+
+        validator.check(&heap, operation);
+        if (heap.getSize() != (long long)model.size()) {
+            fail(operation, "size differs");
+        }
+    }
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+// Without libFuzzer: replays the files given on the command line, or runs
+// random inputs when none are given.
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+        }
+        return 0;
+    }
+
+    const int runs = 2000;
+    std::mt19937 random(1);
+    for (int run = 0; run < runs; run++) {
+        std::vector<uint8_t> bytes(random() % 1024);
+        for (uint8_t& b : bytes) {
+            b = uint8_t(random());
+        }
+        LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+    }
+    std::cout << runs << " random inputs passed" << std::endl;
+    return 0;
+}
+#endif
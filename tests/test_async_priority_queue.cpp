@@ -0,0 +1,163 @@
+#include "../AsyncPriorityQueue.h"
+#include "../EventLoop.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Drives AsyncPriorityQueue through EventLoop and checks which coroutine gets
+// which value. Exits with 1 on the first failed check.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+// Pops count values and records them with the consumer's number.
+static AsyncTask consume(int consumer, AsyncPriorityQueue& queue, int count,
+    std::vector<std::pair<int, long long>>& received) {
+    for (int i = 0; i < count; i++) {
+        long long value = co_await queue.pop();
+        received.push_back(std::make_pair(consumer, value));
+    }
+}
+
+// Pops count values, yielding to the loop after each one.
+static AsyncTask consumeSlowly(EventLoop& loop, AsyncPriorityQueue& queue, int count, std::vector<long long>& received) {
+    for (int i = 0; i < count; i++) {
+        received.push_back(co_await queue.pop());
+        co_await loop.schedule();
+    }
+}
+
+// Pushes the batches one loop turn apart.
+static AsyncTask produce(EventLoop& loop, AsyncPriorityQueue& queue, std::vector<std::vector<long long>> batches) {
+    for (const std::vector<long long>& batch : batches) {
+        if (batch.size() == 1) {
+            queue.push(batch[0]);
+        }
+        else {
+            queue.push(batch);
+        }
+        co_await loop.schedule();
+    }
+}
+
+static void testWaitersGetSmallestValuesInArrivalOrder() {
+    AsyncPriorityQueue queue;
+    std::vector<std::pair<int, long long>> received;
+    consume(1, queue, 1, received);
+    consume(2, queue, 1, received);
+    consume(3, queue, 1, received);
+    check(queue.getWaiterCount() == 3, "three consumers wait on an empty queue");
+    check(received.empty(), "no consumer runs before a push");
+
+    queue.push(std::vector<long long>{ 9, 5, 3, 7 });
+    std::vector<std::pair<int, long long>> expected = { { 1, 3 }, { 2, 5 }, { 3, 7 } };
+    check(received == expected, "a batch hands its smallest values to the oldest waiters");
+    check(queue.getWaiterCount() == 0, "every waiter was resumed");
+    check(queue.getSize() == 1, "the value left over stays queued");
+}
+
+static void testPopIsReadyWhenValuesAreQueued() {
+    AsyncPriorityQueue queue;
+    queue.push(4);
+    queue.push(2);
+    std::vector<std::pair<int, long long>> received;
+    consume(1, queue, 2, received);
+    std::vector<std::pair<int, long long>> expected = { { 1, 2 }, { 1, 4 } };
+    check(received == expected, "queued values are popped at once in increasing order");
+    check(queue.isEmpty() && queue.getWaiterCount() == 0, "the queue is drained without waiting");
+}
+
+static void testProducerAndConsumersOnTheLoop() {
+    EventLoop loop;
+    AsyncPriorityQueue queue;
+    std::vector<long long> first;
+    std::vector<long long> second;
+    consumeSlowly(loop, queue, 3, first);
+    consumeSlowly(loop, queue, 3, second);
+    produce(loop, queue, { { 6 }, { 8, 1, 4 }, { 2 }, { 9 } });
+    loop.run();
+
+    check(first.size() == 3 && second.size() == 3, "both consumers got all their values");
+    std::vector<long long> all = first;
+    all.insert(all.end(), second.begin(), second.end());
+    std::sort(all.begin(), all.end());
+    std::vector<long long> pushed = { 1, 2, 4, 6, 8, 9 };
+    check(all == pushed, "every pushed value is delivered exactly once");
+    check(first[0] == 6, "the first push wakes the oldest consumer");
+    check(queue.isEmpty() && queue.getWaiterCount() == 0 && loop.isEmpty(), "nothing is left behind");
+}
+
+static void testValuesBeyondInt() {
+    AsyncPriorityQueue queue;
+    std::vector<std::pair<int, long long>> received;
+    consume(1, queue, 2, received);
+    queue.push(std::vector<long long>{ 5000000000LL, -5000000000LL, 3000000000LL });
+    std::vector<std::pair<int, long long>> expected = { { 1, -5000000000LL }, { 1, 3000000000LL } };
+    check(received == expected, "values outside the int range are delivered unchanged");
+    check(queue.getSize() == 1, "the largest value stays queued");
+}
+
+static void testRandomBatches() {
+    std::mt19937 random(12);
+    for (int round = 0; round < 200; round++) {
+        EventLoop loop;
+        AsyncPriorityQueue queue;
+        int consumers = 1 + int(random() % 6);
+        int perConsumer = 1 + int(random() % 20);
+
+        std::vector<std::vector<long long>> batches;
+        std::vector<long long> pushed;
+        int total = consumers * perConsumer + int(random() % 5);
+        while (int(pushed.size()) < total) {
+            std::vector<long long> batch(1 + random() % std::min(8, total - int(pushed.size())));
+            for (long long& value : batch) {
+                value = (long long)(random() % 1000) - 500;
+                pushed.push_back(value);
+            }
+            batches.push_back(batch);
+        }
+
+        std::vector<std::vector<long long>> received(consumers);
+        for (int c = 0; c < consumers; c++) {
+            consumeSlowly(loop, queue, perConsumer, received[c]);
+        }
+        produce(loop, queue, batches);
+        loop.run();
+
+        std::vector<long long> delivered;
+        for (const std::vector<long long>& values : received) {
+            delivered.insert(delivered.end(), values.begin(), values.end());
+        }
+        while (!queue.isEmpty()) {
+            std::vector<std::pair<int, long long>> rest;
+            consume(0, queue, 1, rest);
+            delivered.push_back(rest[0].second);
+        }
+        std::sort(delivered.begin(), delivered.end());
+        std::sort(pushed.begin(), pushed.end());
+        check(delivered == pushed, "random batches: every value is delivered or left queued exactly once");
+        check(queue.getWaiterCount() == 0 && loop.isEmpty(), "random batches: no coroutine is left waiting");
+    }
+}
+
+int main() {
+    testWaitersGetSmallestValuesInArrivalOrder();
+    testPopIsReadyWhenValuesAreQueued();
+    testProducerAndConsumersOnTheLoop();
+    testValuesBeyondInt();
+    testRandomBatches();
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All AsyncPriorityQueue tests passed" << std::endl;
+    return 0;
+}
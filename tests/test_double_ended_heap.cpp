@@ -0,0 +1,146 @@
+#include "../DoubleEndedHeap.h"
+#include <climits>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Runs random sequences of insert, extractMin, extractMax and erase against a
+// std::multiset and checks both ends, keyOf, contains and the size after every
+// step. Small key ranges make equal keys common.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+// The model keeps (key, id) pairs, the live handles and the element behind
+// every handle; ids are unique, so an extracted id names exactly one element.
+struct Model {
+    std::multiset<std::pair<long long, int>> elements;
+    std::map<int, std::pair<long long, int>> byHandle;
+    std::vector<int> handles;
+};
+
+static void removeFromModel(Model& model, int id, long long key) {
+    model.elements.erase(model.elements.find(std::make_pair(key, id)));
+    for (size_t i = 0; i < model.handles.size(); i++) {
+        int handle = model.handles[i];
+        if (model.byHandle[handle].second == id) {
+            model.byHandle.erase(handle);
+            model.handles[i] = model.handles.back();
+            model.handles.pop_back();
+            return;
+        }
+    }
+}
+
+static void testEmptyHeap() {
+    DoubleEndedHeap heap;
+    long long key = 1;
+    int id = 1;
+    check(heap.isEmpty() && heap.getSize() == 0, "a new heap is empty");
+    check(!heap.extractMin(key, id) && !heap.extractMax(key, id), "extracting from an empty heap fails");
+    check(!heap.erase(0) && !heap.contains(0) && !heap.contains(-1), "no handle is in use in an empty heap");
+}
+
+static void testRandomOperations(unsigned seed, int steps, long long keyRange) {
+    std::mt19937 random(seed);
+    DoubleEndedHeap heap;
+    Model model;
+    int nextId = 0;
+    bool matches = true;
+
+    for (int step = 0; step < steps && matches; step++) {
+        int operation = int(random() % 10);
+        long long key = 0;
+        int id = -1;
+
+        if (operation < 4 || model.elements.empty()) {
+            key = (long long)(random() % keyRange) - keyRange / 2;
+            int handle = heap.insert(key, nextId);
+            matches = model.byHandle.count(handle) == 0 && heap.contains(handle) && heap.keyOf(handle) == key;
+            model.elements.insert(std::make_pair(key, nextId));
+            model.byHandle[handle] = std::make_pair(key, nextId);
+            model.handles.push_back(handle);
+            nextId += 1;
+        }
+        else if (operation < 6) {
+            matches = heap.extractMin(key, id) && key == model.elements.begin()->first
+                && model.elements.count(std::make_pair(key, id)) == 1;
+            if (matches) {
+                removeFromModel(model, id, key);
+            }
+        }
+        else if (operation < 8) {
+            matches = heap.extractMax(key, id) && key == model.elements.rbegin()->first
+                && model.elements.count(std::make_pair(key, id)) == 1;
+            if (matches) {
+                removeFromModel(model, id, key);
+            }
+        }
+        else {
+            size_t at = random() % model.handles.size();
+            int handle = model.handles[at];
+            std::pair<long long, int> element = model.byHandle[handle];
+            matches = heap.erase(handle) && !heap.contains(handle) && !heap.erase(handle);
+            removeFromModel(model, element.second, element.first);
+        }
+
+        matches = matches && heap.getSize() == int(model.elements.size())
+            && heap.isEmpty() == model.elements.empty();
+        if (matches && !model.elements.empty()) {
+            matches = heap.getMinValue() == model.elements.begin()->first
+                && heap.getMaxValue() == model.elements.rbegin()->first;
+        }
+        // keyOf is checked for a few live handles per step to keep the run short.
+        for (int i = 0; i < 3 && matches && !model.handles.empty(); i++) {
+            int handle = model.handles[random() % model.handles.size()];
+            matches = heap.contains(handle) && heap.keyOf(handle) == model.byHandle[handle].first;
+        }
+    }
+    check(matches, "random operations match a std::multiset");
+
+    // Draining alternately from both ends must give back every element.
+    long long low = LLONG_MIN;
+    long long high = LLONG_MAX;
+    bool fromMin = true;
+    while (matches && !model.elements.empty()) {
+        long long key = 0;
+        int id = -1;
+        if (fromMin) {
+            matches = heap.extractMin(key, id) && key >= low && key == model.elements.begin()->first;
+            low = key;
+        }
+        else {
+            matches = heap.extractMax(key, id) && key <= high && key == model.elements.rbegin()->first;
+            high = key;
+        }
+        if (matches) {
+            model.elements.erase(model.elements.find(std::make_pair(key, id)));
+        }
+        fromMin = !fromMin;
+    }
+    check(matches && heap.isEmpty(), "draining both ends returns every element in order");
+}
+
+int main() {
+    testEmptyHeap();
+    for (unsigned seed = 1; seed <= 50; seed++) {
+        testRandomOperations(seed, 2000, 16);
+        testRandomOperations(seed, 2000, 1000000);
+    }
+    testRandomOperations(99, 200000, 64);
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All DoubleEndedHeap tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "../HeapSnapshot.h"
+#include "../HeapValidator.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+// Round trips plain and indexed heaps through snapshot files, checking that a
+// restored heap is valid, saves to the same bytes and extracts the same
+// elements, and that damaged or unsuitable files are rejected.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), std::streamsize(contents.size()));
+}
+
+// Builds a heap with consolidated trees and marked nodes, so the snapshot
+// has to carry more than a root list.
+static void fillHeap(FibonacciHeap& heap, unsigned seed, int count) {
+    std::mt19937 random(seed);
+    std::vector<Node*> nodes;
+    for (int i = 0; i < count; i++) {
+        nodes.push_back(heap.insert((long long)(random() % 1000000) - 500000, i));
+    }
+    Node* extracted = heap.extractMin();
+    for (Node*& node : nodes) {
+        if (node == extracted) {
+            node = nullptr;
+        }
+    }
+    delete extracted;
+    for (int i = 0; i < count / 4; i++) {
+        Node* node = nodes[random() % nodes.size()];
+        if (node != nullptr) {
+            heap.decreaseKey(node, node->getKey() - 1 - (long long)(random() % 1000));
+        }
+    }
+}
+
+static void testPlainRoundTrip(const std::string& directory) {
+    HeapSnapshot snapshot;
+    std::string first = directory + "/plain.snap";
+    std::string second = directory + "/plain_again.snap";
+    for (int count : { 0, 1, 2, 1000, 50000 }) {
+        FibonacciHeap heap;
+        if (count > 0) {
+            fillHeap(heap, unsigned(count), count);
+        }
+        check(snapshot.save(&heap, first), "a heap can be saved");
+
+        FibonacciHeap* restored = snapshot.load(first);
+        check(restored != nullptr, "a saved heap can be loaded");
+        if (restored == nullptr) {
+            continue;
+        }
+        std::string error;
+        check(HeapValidator().validate(restored, error), "a restored heap is valid");
+        check(restored->getSize() == heap.getSize(), "a restored heap has the same size");
+        check(snapshot.save(restored, second) && readFile(first) == readFile(second),
+            "a restored heap saves to the same bytes");
+
+        bool same = true;
+        while (same && !heap.isEmpty()) {
+            Node* expected = heap.extractMin();
+            Node* actual = restored->extractMin();
+            same = actual != nullptr && actual->getKey() == expected->getKey() && actual->getId() == expected->getId();
+            delete expected;
+            delete actual;
+        }
+        check(same && restored->isEmpty(), "a restored heap extracts the same elements in the same order");
+        delete restored;
+    }
+}
+
+static void testIndexedRoundTrip(const std::string& directory) {
+    HeapSnapshot snapshot;
+    std::string first = directory + "/indexed.snap";
+    std::string second = directory + "/indexed_again.snap";
+
+    // Ids over several blocks, with keys moved both ways and some ids removed.
+    std::mt19937 random(11);
+    IndexedFibonacciHeap heap;
+    for (int step = 0; step < 60000; step++) {
+        int id = int(random() % 20000);
+        if (step % 7 == 6) {
+            heap.erase(id);
+        }
+        else {
+            heap.upsert(id, (long long)(random() % 100000));
+        }
+        if (step % 1000 == 999) {
+            heap.extractMin();
+        }
+    }
+    check(snapshot.save(&heap, first), "an indexed heap can be saved");
+
+    IndexedFibonacciHeap* restored = snapshot.loadIndexed(first);
+    check(restored != nullptr, "a saved indexed heap can be loaded");
+    if (restored == nullptr) {
+        return;
+    }
+    check(restored->getSize() == heap.getSize(), "a restored indexed heap has the same size");
+    check(snapshot.save(restored, second) && readFile(first) == readFile(second),
+        "a restored indexed heap saves to the same bytes");
+
+    bool same = true;
+    for (int id = 0; id < 20000 && same; id++) {
+        same = restored->contains(id) == heap.contains(id);
+    }
+    check(same, "a restored indexed heap contains the same ids");
+
+    // The restored heap must keep working, not only drain.
+    restored->upsert(25000, -1);
+    heap.upsert(25000, -1);
+    while (same && !heap.isEmpty()) {
+        long long key = heap.getMinValue();
+        same = restored->getMinValue() == key && restored->extractMin() == heap.extractMin();
+    }
+    check(same && restored->isEmpty(), "a restored indexed heap extracts the same ids in the same order");
+    delete restored;
+
+    // A snapshot of a plain heap with unique ids restores into blocks as well.
+    FibonacciHeap plain;
+    fillHeap(plain, 5, 10000);
+    snapshot.save(&plain, first);
+    restored = snapshot.loadIndexed(first);
+    check(restored != nullptr && restored->getSize() == plain.getSize(),
+        "a plain snapshot with unique ids can be loaded as an indexed heap");
+    same = restored != nullptr;
+    while (same && !plain.isEmpty()) {
+        Node* expected = plain.extractMin();
+        same = restored->extractMin() == expected->getId();
+        delete expected;
+    }
+    check(same, "a plain snapshot loaded as an indexed heap extracts the same ids");
+    delete restored;
+
+    FibonacciHeap withoutIds;
+    withoutIds.insert(3);
+    withoutIds.insert(4);
+    snapshot.save(&withoutIds, first);
+    check(snapshot.loadIndexed(first) == nullptr, "loadIndexed rejects negative ids");
+
+    FibonacciHeap repeated;
+    repeated.insert(3, 7);
+    repeated.insert(4, 7);
+    snapshot.save(&repeated, first);
+    check(snapshot.loadIndexed(first) == nullptr, "loadIndexed rejects repeated ids");
+}
+
+static void testCorruption(const std::string& directory) {
+    HeapSnapshot snapshot;
+    std::string path = directory + "/corrupt.snap";
+    std::string damaged = directory + "/damaged.snap";
+    FibonacciHeap heap;
+    fillHeap(heap, 3, 2000);
+    snapshot.save(&heap, path);
+    std::string contents = readFile(path);
+
+    // One flipped bit anywhere, in the header, a record or the checksum.
+    bool rejected = true;
+    for (size_t at = 0; at < contents.size(); at += 97) {
+        std::string changed = contents;
+        changed[at] = char(changed[at] ^ 0x10);
+        writeFile(damaged, changed);
+        FibonacciHeap* restored = snapshot.load(damaged);
+        rejected = rejected && restored == nullptr;
+        delete restored;
+    }
+    check(rejected, "a snapshot with a flipped bit is rejected");
+
+    writeFile(damaged, contents.substr(0, contents.size() - 5));
+    check(snapshot.load(damaged) == nullptr, "a truncated snapshot is rejected");
+    writeFile(damaged, contents + "x");
+    check(snapshot.load(damaged) == nullptr, "a snapshot with trailing bytes is rejected");
+    writeFile(damaged, "");
+    check(snapshot.load(damaged) == nullptr, "an empty file is rejected");
+    check(snapshot.load(directory + "/missing.snap") == nullptr, "a missing file is rejected");
+    check(snapshot.loadIndexed(directory + "/missing.snap") == nullptr, "loadIndexed rejects a missing file");
+
+    std::string older = contents;
+    older[8] = 2;
+    writeFile(damaged, older);
+    check(snapshot.load(damaged) == nullptr, "a snapshot of an older format version is rejected");
+}
+
+// The snapshot files are written to the directory given as the first
+// argument, the current one by default, and removed at the end.
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : ".";
+    testPlainRoundTrip(directory);
+    testIndexedRoundTrip(directory);
+    testCorruption(directory);
+    for (const char* name : { "plain", "plain_again", "indexed", "indexed_again", "corrupt", "damaged" }) {
+        std::remove((directory + "/" + name + ".snap").c_str());
+    }
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All HeapSnapshot tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "../IndexedFibonacciHeap.h"
+#include <climits>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+
+// Runs random upsert, erase and extractMin sequences against a std::map from
+// id to key, with ids spanning several blocks of nodes, and compares the
+// minimum, the size and the keys after every step.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+static void testRandomOperations(unsigned seed, int steps, int idRange, long long keyRange) {
+    std::mt19937 random(seed);
+    IndexedFibonacciHeap heap(seed % 2 == 0 ? idRange : 0);
+    std::map<int, long long> model;
+    std::set<std::pair<long long, int>> order;
+    bool matches = true;
+    bool increased = false;
+    bool decreased = false;
+
+    for (int step = 0; step < steps && matches; step++) {
+        int operation = int(random() % 10);
+        int id = int(random() % idRange);
+        if (operation < 6) {
+            long long key = (long long)(random() % keyRange) - keyRange / 2;
+            heap.upsert(id, key);
+            if (model.count(id) != 0) {
+                increased = increased || key > model[id];
+                decreased = decreased || key < model[id];
+                order.erase(std::make_pair(model[id], id));
+            }
+            model[id] = key;
+            order.insert(std::make_pair(key, id));
+        }
+        else if (operation < 8) {
+            heap.erase(id);
+            if (model.count(id) != 0) {
+                order.erase(std::make_pair(model[id], id));
+                model.erase(id);
+            }
+        }
+        else if (!model.empty()) {
+            int extracted = heap.extractMin();
+            matches = model.count(extracted) != 0 && model[extracted] == order.begin()->first;
+            if (matches) {
+                order.erase(std::make_pair(model[extracted], extracted));
+                model.erase(extracted);
+            }
+        }
+        else {
+            matches = heap.extractMin() == -1 && heap.getMinId() == -1;
+        }
+
+        matches = matches && heap.getSize() == (long long)model.size() && heap.isEmpty() == model.empty();
+        if (matches && !model.empty()) {
+            matches = heap.getMinValue() == order.begin()->first && model[heap.getMinId()] == order.begin()->first;
+        }
+        long long key = LLONG_MIN;
+        bool present = model.count(id) != 0;
+        matches = matches && heap.contains(id) == present && heap.keyOf(id, key) == present
+            && key == (present ? model[id] : LLONG_MIN);
+    }
+    check(matches, "random operations match a std::map");
+    check(increased && decreased, "upsert moved keys in both directions");
+
+    long long previous = LLONG_MIN;
+    while (matches && !heap.isEmpty()) {
+        long long key = heap.getMinValue();
+        int id = heap.extractMin();
+        matches = key >= previous && model.count(id) != 0 && model[id] == key && !heap.contains(id);
+        model.erase(id);
+        previous = key;
+    }
+    check(matches && model.empty(), "draining returns every id in key order");
+}
+
+static void testEdgeCases() {
+    IndexedFibonacciHeap heap;
+    long long key = 42;
+    check(!heap.keyOf(0, key) && !heap.keyOf(-1, key) && key == 42, "keyOf reports absent ids without touching the key");
+
+    heap.upsert(-3, 5);
+    check(heap.isEmpty() && !heap.contains(-3), "negative ids are rejected");
+
+    // A key of 0 is a key like any other.
+    heap.upsert(5000, 0);
+    check(heap.keyOf(5000, key) && key == 0, "keyOf tells a key of 0 from an absent id");
+
+    // Ids far apart land in different blocks, created on demand.
+    heap.upsert(1000000, -7);
+    heap.upsert(12, 3);
+    check(heap.getSize() == 3 && heap.getMinId() == 1000000, "ids in distant blocks share one heap");
+    heap.erase(1000000);
+    heap.erase(1000000);
+    check(heap.getSize() == 2 && heap.getMinId() == 5000, "erasing an id twice removes it once");
+    heap.upsert(1000000, 1);
+    check(heap.extractMin() == 5000 && heap.extractMin() == 1000000 && heap.extractMin() == 12
+        && heap.extractMin() == -1, "an erased id can be inserted again");
+}
+
+int main() {
+    for (unsigned seed = 1; seed <= 40; seed++) {
+        testRandomOperations(seed, 5000, 64, 16);
+        testRandomOperations(seed, 5000, 20000, 1000000);
+    }
+    testRandomOperations(99, 300000, 100000, 1LL << 40);
+    testEdgeCases();
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All IndexedFibonacciHeap tests passed" << std::endl;
+    return 0;
+}
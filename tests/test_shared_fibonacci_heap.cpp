@@ -0,0 +1,335 @@
+#include "../SharedFibonacciHeap.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Compares SharedFibonacciHeap with a std::multiset, lets several processes
+// insert and extract concurrently, and kills a process in the middle of its
+// operations to check that the poisoned heap refuses work until repair and
+// then still holds every element.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+static std::string regionName(const char* test) {
+    return std::string("/fibheap_test_") + test + "_" + std::to_string(::getpid());
+}
+
+// Maps memory that forked children share with the parent, for their logs.
+static void* mapShared(size_t bytes) {
+    void* memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+static void testMatchesMultiset(unsigned seed) {
+    const int capacity = 3000;
+    std::string name = regionName("multiset");
+    SharedFibonacciHeap::remove(name);
+    SharedFibonacciHeap* heap = SharedFibonacciHeap::create(name, capacity);
+    check(heap != nullptr, "a region can be created");
+    if (heap == nullptr) {
+        return;
+    }
+
+    std::mt19937 random(seed);
+    std::map<int, std::pair<int, long long>> live;   // id -> (slot, key)
+    std::set<std::pair<long long, int>> order;      // (key, id)
+    int nextId = 0;
+    bool matches = true;
+    bool growing = true;
+    int filled = 0;
+    for (int step = 0; step < 200000 && matches; step++) {
+        // The heap grows until an insert fails because the region is full and
+        // then shrinks to half, so the free list and the full case are
+        // exercised too.
+        int operation = int(random() % 10);
+        bool inserting = growing ? operation < 6 : operation < 3;
+        if (!growing && int(live.size()) < capacity / 2) {
+            growing = true;
+        }
+        if (inserting) {
+            long long key = (long long)(random() % 100000) - 50000;
+            int slot = heap->insert(key, nextId);
+            if (int(live.size()) == capacity) {
+                matches = slot == -1;
+                filled += 1;
+                growing = false;
+            }
+            else {
+                matches = slot >= 0 && slot < capacity;
+                live[nextId] = std::make_pair(slot, key);
+                order.insert(std::make_pair(key, nextId));
+            }
+            nextId += 1;
+        }
+        else if (operation < 8 && !live.empty()) {
+            long long key = 0;
+            int id = -1;
+            matches = heap->extractMin(key, id) && key == order.begin()->first
+                && live.count(id) != 0 && live[id].second == key;
+            if (matches) {
+                order.erase(std::make_pair(key, id));
+                live.erase(id);
+            }
+        }
+        else if (!live.empty()) {
+            std::map<int, std::pair<int, long long>>::iterator entry = live.lower_bound(int(random() % nextId));
+            if (entry == live.end()) {
+                entry = live.begin();
+            }
+            long long key = entry->second.second - (long long)(random() % 1000);
+            heap->decreaseKey(entry->second.first, key);
+            order.erase(std::make_pair(entry->second.second, entry->first));
+            order.insert(std::make_pair(key, entry->first));
+            entry->second.second = key;
+        }
+
+        matches = matches && heap->getSize() == int(live.size()) && heap->isEmpty() == live.empty()
+            && (live.empty() || heap->getMinValue() == order.begin()->first);
+    }
+    check(matches, "random operations match a std::multiset");
+    check(filled > 0, "inserting into a full region fails");
+
+    long long previous = 0;
+    bool first = true;
+    long long key = 0;
+    int id = -1;
+    while (matches && heap->extractMin(key, id)) {
+        matches = (first || key >= previous) && live.count(id) != 0 && live[id].second == key;
+        live.erase(id);
+        previous = key;
+        first = false;
+    }
+    check(matches && live.empty(), "draining returns every element in key order");
+
+    delete heap;
+    SharedFibonacciHeap::remove(name);
+}
+
+static void testProcesses() {
+    const int children = 4;
+    const int perChild = 5000;
+    std::string name = regionName("processes");
+    SharedFibonacciHeap::remove(name);
+    SharedFibonacciHeap* heap = SharedFibonacciHeap::create(name, children * perChild);
+    int* extractedBy = static_cast<int*>(mapShared(sizeof(int) * children * perChild));
+    int* extractedCount = static_cast<int*>(mapShared(sizeof(int) * children));
+    check(heap != nullptr && extractedBy != nullptr && extractedCount != nullptr, "a region can be created");
+    if (heap == nullptr || extractedBy == nullptr || extractedCount == nullptr) {
+        return;
+    }
+
+    // Every child opens the region by name, inserts its own ids and extracts
+    // about half as many elements, which may have been inserted by any child.
+    std::vector<pid_t> pids;
+    for (int c = 0; c < children; c++) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            SharedFibonacciHeap* shared = SharedFibonacciHeap::open(name);
+            if (shared == nullptr) {
+                ::_exit(1);
+            }
+            std::mt19937 random(unsigned(c + 1));
+            int count = 0;
+            for (int i = 0; i < perChild; i++) {
+                if (shared->insert((long long)(random() % 1000000), c * perChild + i) == -1) {
+                    ::_exit(2);
+                }
+                long long key = 0;
+                int id = -1;
+                if (i % 2 == 1 && shared->extractMin(key, id)) {
+                    extractedBy[c * perChild + count] = id;
+                    count += 1;
+                }
+            }
+            extractedCount[c] = count;
+            delete shared;
+            ::_exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    bool exited = true;
+    for (pid_t pid : pids) {
+        int status = 0;
+        exited = exited && pid > 0 && ::waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    check(exited, "every child process finished its operations");
+
+    std::vector<int> seen(size_t(children * perChild), 0);
+    int total = 0;
+    for (int c = 0; c < children; c++) {
+        for (int i = 0; i < extractedCount[c]; i++) {
+            seen[size_t(extractedBy[c * perChild + i])] += 1;
+            total += 1;
+        }
+    }
+    check(heap->getSize() == children * perChild - total, "the size counts the elements left by all processes");
+
+    long long previous = 0;
+    bool ordered = true;
+    long long key = 0;
+    int id = -1;
+    while (heap->extractMin(key, id)) {
+        ordered = ordered && key >= previous;
+        previous = key;
+        seen[size_t(id)] += 1;
+    }
+    bool once = true;
+    for (int count : seen) {
+        once = once && count == 1;
+    }
+    check(ordered, "the parent drains the remaining elements in key order");
+    check(once, "every element inserted by any process is extracted exactly once");
+
+    ::munmap(extractedBy, sizeof(int) * children * perChild);
+    ::munmap(extractedCount, sizeof(int) * children);
+    delete heap;
+    SharedFibonacciHeap::remove(name);
+}
+
+// What a child reports about its own operations, in memory shared with the parent.
+struct ChildLog {
+    int inserted;                  ///< Number of inserts that returned, ids 0 to inserted - 1
+    int extracting;                ///< 1 from the start of an extractMin until its id is logged
+    unsigned char extracted[1 << 18]; ///< 1 for every id an extractMin returned
+};
+
+static void testKillAndRepair() {
+    const int maxIds = 1 << 18;
+    std::string name = regionName("kill");
+    ChildLog* log = static_cast<ChildLog*>(mapShared(sizeof(ChildLog)));
+    check(log != nullptr, "the child log can be mapped");
+    if (log == nullptr) {
+        return;
+    }
+
+    int poisonedRounds = 0;
+    bool refused = true;
+    bool repaired = true;
+    bool complete = true;
+    bool ordered = true;
+    for (int round = 0; round < 20; round++) {
+        SharedFibonacciHeap::remove(name);
+        SharedFibonacciHeap* heap = SharedFibonacciHeap::create(name, maxIds);
+        if (heap == nullptr) {
+            check(false, "a region can be created");
+            break;
+        }
+        log->inserted = 0;
+        log->extracting = 0;
+        std::fill(log->extracted, log->extracted + maxIds, 0);
+
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            SharedFibonacciHeap* shared = SharedFibonacciHeap::open(name);
+            std::mt19937 random(static_cast<unsigned>(round));
+            std::vector<int> slotOf;
+            std::vector<long long> keyOf;
+            while (shared != nullptr) {
+                int operation = int(random() % 4);
+                int id = int(slotOf.size());
+                if (operation < 2 && id < maxIds) {
+                    long long key = (long long)(random() % 1000000);
+                    slotOf.push_back(shared->insert(key, id));
+                    keyOf.push_back(key);
+                    __atomic_store_n(&log->inserted, id + 1, __ATOMIC_SEQ_CST);
+                }
+                else if (operation == 2) {
+                    long long key = 0;
+                    int extracted = -1;
+                    __atomic_store_n(&log->extracting, 1, __ATOMIC_SEQ_CST);
+                    if (shared->extractMin(key, extracted)) {
+                        __atomic_store_n(&log->extracted[extracted], 1, __ATOMIC_SEQ_CST);
+                    }
+                    __atomic_store_n(&log->extracting, 0, __ATOMIC_SEQ_CST);
+                }
+                else if (id > 0) {
+                    int target = int(random() % id);
+                    if (log->extracted[target] == 0) {
+                        keyOf[target] -= (long long)(random() % 1000);
+                        shared->decreaseKey(slotOf[target], keyOf[target]);
+                    }
+                }
+            }
+            ::_exit(1);
+        }
+
+        ::usleep(useconds_t(20000 + 3000 * round));
+        ::kill(pid, SIGKILL);
+        ::waitpid(pid, nullptr, 0);
+
+        if (heap->isPoisoned()) {
+            poisonedRounds += 1;
+            long long key = 0;
+            int id = -1;
+            refused = refused && !heap->extractMin(key, id) && heap->insert(1) == -1;
+            repaired = repaired && heap->repair() && !heap->isPoisoned();
+        }
+
+        // Every id that was inserted and not extracted must come back exactly
+        // once. The one operation the child was in when it died may or may not
+        // have happened: its insert may be there, and an extractMin it was in
+        // may have removed an id without logging it.
+        std::vector<int> seen(size_t(maxIds), 0);
+        int size = heap->getSize();
+        int drained = 0;
+        long long previous = 0;
+        long long key = 0;
+        int id = -1;
+        while (heap->extractMin(key, id)) {
+            ordered = ordered && (drained == 0 || key >= previous);
+            previous = key;
+            drained += 1;
+            complete = complete && id >= 0 && id <= log->inserted && id < maxIds && log->extracted[id] == 0;
+            if (id >= 0 && id < maxIds) {
+                seen[size_t(id)] += 1;
+            }
+        }
+        int missing = 0;
+        for (int i = 0; i < log->inserted; i++) {
+            complete = complete && seen[size_t(i)] <= 1;
+            missing += log->extracted[i] == 0 && seen[size_t(i)] == 0;
+        }
+        complete = complete && missing <= log->extracting && drained == size;
+
+        delete heap;
+    }
+    SharedFibonacciHeap::remove(name);
+    ::munmap(log, sizeof(ChildLog));
+
+    check(poisonedRounds > 0, "killing a process in the middle of its operations poisons the heap");
+    check(refused, "a poisoned heap refuses operations");
+    check(repaired, "repair makes a poisoned heap usable again");
+    check(ordered, "a repaired heap extracts in key order");
+    check(complete, "a repaired heap holds every element that was not extracted, once");
+}
+
+int main() {
+    for (unsigned seed = 1; seed <= 5; seed++) {
+        testMatchesMultiset(seed);
+    }
+    testProcesses();
+    testKillAndRepair();
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All SharedFibonacciHeap tests passed" << std::endl;
+    return 0;
+}
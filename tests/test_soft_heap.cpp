@@ -0,0 +1,160 @@
+#include "../Selection.h"
+#include "../SoftHeap.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Checks the error bound of SoftHeap from the outside and compares Selection
+// with std::nth_element and the quantile bounds it promises.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+// During a run of extractions without inserts the corrupted keys handed out
+// never decrease, so an element still in the heap whose key is below the
+// largest key extracted in the run must be corrupted. There may be at most
+// errorRate times the number of insertions of those, at every point.
+static void testErrorBound(unsigned seed, double errorRate, int rounds, long long keyRange) {
+    std::mt19937 random(seed);
+    SoftHeap heap(errorRate);
+    std::vector<long long> present;   // Original keys of the elements in the heap, by id
+    std::vector<bool> removed;
+    long long inserted = 0;
+    long long worstCorrupted = 0;
+    bool exact = true;
+    bool bounded = true;
+
+    for (int round = 0; round < rounds; round++) {
+        int batch = 1 + int(random() % 500);
+        for (int i = 0; i < batch; i++) {
+            long long key = (long long)(random() % keyRange);
+            heap.insert(key, int(present.size()));
+            present.push_back(key);
+            removed.push_back(false);
+            inserted += 1;
+        }
+
+        int extractions = int(random() % (heap.getSize() + 1));
+        long long largest = LLONG_MIN;
+        for (int i = 0; i < extractions; i++) {
+            long long key;
+            int id;
+            exact = exact && heap.extractMin(key, id) && id >= 0 && id < int(present.size())
+                && !removed[id] && present[id] == key;
+            if (!exact) {
+                break;
+            }
+            removed[id] = true;
+            largest = std::max(largest, key);
+
+            // Counting the whole heap after every extraction is quadratic, so
+            // only every 16th one and the last one of a run are counted.
+            if (i % 16 == 15 || i + 1 == extractions) {
+                long long corrupted = 0;
+                for (size_t j = 0; j < present.size(); j++) {
+                    corrupted += !removed[j] && present[j] < largest;
+                }
+                worstCorrupted = std::max(worstCorrupted, corrupted);
+                bounded = bounded && double(corrupted) <= errorRate * double(inserted);
+            }
+        }
+        if (!exact || !bounded) {
+            break;
+        }
+    }
+
+    long long left = 0;
+    for (size_t j = 0; j < present.size(); j++) {
+        left += !removed[j];
+    }
+    check(exact, "every extracted element is one that was inserted, with its original key");
+    check(bounded, "at most errorRate * n elements are overtaken by larger extracted keys");
+    check(heap.getSize() == left, "the size counts the elements not yet extracted");
+    if (!bounded) {
+        std::cout << "  error rate " << errorRate << ": " << worstCorrupted << " of " << inserted << std::endl;
+    }
+}
+
+static void testSelectMatchesNthElement() {
+    Selection selection;
+    std::mt19937 random(5);
+    bool matches = true;
+    for (int round = 0; round < 300 && matches; round++) {
+        int n = 1 + int(random() % (round < 200 ? 40 : 5000));
+        long long range = round % 3 == 0 ? 8 : 1000000000;
+        std::vector<long long> values(static_cast<size_t>(n));
+        for (long long& value : values) {
+            value = (long long)(random() % range) - range / 2;
+        }
+
+        // Every rank of the small inputs, a few random ranks of the large ones.
+        for (int probe = 0; probe < std::min(n, 8) && matches; probe++) {
+            long long k = n <= 8 ? probe : (long long)(random() % n);
+            std::vector<long long> sorted = values;
+            std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+            matches = selection.select(values, k) == sorted[k];
+        }
+    }
+    check(matches, "select returns the same value as std::nth_element");
+
+    std::vector<long long> sorted(100000);
+    for (size_t i = 0; i < sorted.size(); i++) {
+        sorted[i] = (long long)i;
+    }
+    std::vector<long long> reversed(sorted.rbegin(), sorted.rend());
+    check(selection.select(sorted, 50000) == 50000 && selection.select(reversed, 99999) == 99999,
+        "select handles sorted and reversed input");
+}
+
+static void testApproximateQuantileBounds() {
+    Selection selection;
+    std::mt19937 random(8);
+    bool bounded = true;
+    const double rates[] = { 0.5, 1.0 / 3.0, 0.1, 0.01 };
+    const double quantiles[] = { 0.0, 0.01, 0.25, 0.5, 0.9, 1.0 };
+    for (double errorRate : rates) {
+        for (double q : quantiles) {
+            int n = 1 + int(random() % 20000);
+            std::vector<long long> values(static_cast<size_t>(n));
+            for (long long& value : values) {
+                value = (long long)(random() % 1000);
+            }
+            long long result = selection.approximateQuantile(values, q, errorRate);
+
+            // At least the ceil(q * n) extracted values are not above the result,
+            // and at most errorRate * n values below it were not extracted.
+            long long wanted = std::max(1LL, (long long)std::ceil(q * n));
+            long long below = std::count_if(values.begin(), values.end(), [result](long long v) { return v < result; });
+            long long notAbove = std::count_if(values.begin(), values.end(), [result](long long v) { return v <= result; });
+            bounded = bounded && notAbove >= wanted && double(below) <= double(wanted - 1) + errorRate * n;
+        }
+    }
+    check(bounded, "approximateQuantile returns a value of rank between q * n and (q + errorRate) * n");
+}
+
+int main() {
+    const double rates[] = { 0.5, 1.0 / 3.0, 0.1, 0.01 };
+    unsigned seed = 1;
+    for (double errorRate : rates) {
+        for (int run = 0; run < 5; run++) {
+            testErrorBound(seed++, errorRate, 40, run % 2 == 0 ? 50 : 1000000000);
+        }
+    }
+    testSelectMatchesNthElement();
+    testApproximateQuantileBounds();
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All SoftHeap and Selection tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "../SplitFibonacciHeap.h"
+#include <climits>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+
+// Runs random upsert, erase and extractMin sequences against a std::map from
+// id to key, with ids spanning many growth steps of the key and link arrays,
+// and compares the minimum, the size and the keys after every step.
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures += 1;
+    }
+}
+
+static void testRandomOperations(unsigned seed, int steps, int idRange, long long keyRange) {
+    std::mt19937 random(seed);
+    SplitFibonacciHeap heap;
+    std::map<int, long long> model;
+    std::set<std::pair<long long, int>> order;
+    bool matches = true;
+
+    for (int step = 0; step < steps && matches; step++) {
+        int operation = int(random() % 10);
+        int id = int(random() % idRange);
+        if (operation < 6) {
+            long long key = (long long)(random() % keyRange) - keyRange / 2;
+            heap.upsert(id, key);
+            if (model.count(id) != 0) {
+                order.erase(std::make_pair(model[id], id));
+            }
+            model[id] = key;
+            order.insert(std::make_pair(key, id));
+        }
+        else if (operation < 8) {
+            heap.erase(id);
+            if (model.count(id) != 0) {
+                order.erase(std::make_pair(model[id], id));
+                model.erase(id);
+            }
+        }
+        else if (!model.empty()) {
+            int extracted = heap.extractMin();
+            matches = model.count(extracted) != 0 && model[extracted] == order.begin()->first;
+            if (matches) {
+                order.erase(std::make_pair(model[extracted], extracted));
+                model.erase(extracted);
+            }
+        }
+        else {
+            matches = heap.extractMin() == -1;
+        }
+
+        matches = matches && heap.getSize() == (long long)model.size() && heap.isEmpty() == model.empty();
+        if (matches && !model.empty()) {
+            matches = heap.getMinValue() == order.begin()->first && model[heap.getMinId()] == order.begin()->first;
+        }
+        long long key = 0;
+        matches = matches && heap.contains(id) == (model.count(id) != 0)
+            && heap.keyOf(id, key) == (model.count(id) != 0) && (model.count(id) == 0 || key == model[id]);
+    }
+    check(matches, "random operations match a std::map");
+
+    long long previous = LLONG_MIN;
+    while (matches && !heap.isEmpty()) {
+        long long key = heap.getMinValue();
+        int id = heap.extractMin();
+        matches = key >= previous && model.count(id) != 0 && model[id] == key;
+        model.erase(id);
+        previous = key;
+    }
+    check(matches && model.empty(), "draining returns every id in key order");
+}
+
+int main() {
+    for (unsigned seed = 1; seed <= 40; seed++) {
+        testRandomOperations(seed, 5000, 64, 16);
+        testRandomOperations(seed, 5000, 20000, 1000000);
+    }
+    testRandomOperations(99, 300000, 100000, 1LL << 40);
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All SplitFibonacciHeap tests passed" << std::endl;
+    return 0;
+}
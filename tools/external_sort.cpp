@@ -0,0 +1,16 @@
+#include "../ExternalSort.h"
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <input> <output> [run elements] [temp directory]" << std::endl;
+        return 1;
+    }
+
+    size_t runElements = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : size_t(1) << 24;
+    std::string tempDirectory = argc > 4 ? argv[4] : ".";
+
+    ExternalSort sorter(runElements, size_t(1) << 20, tempDirectory);
+    return sorter.sort(argv[1], argv[2]) ? 0 : 1;
+}